@@ -18,6 +18,63 @@ OUTPUT_DIR=${OUTPUT_DIR:-/data/output}
 ROLLING_INTERVAL=${ROLLING_INTERVAL:-0}
 PARSER_THREADS=${PARSER_THREADS:-0}
 
+# 캡처 백엔드 설정 (pcap | tpacket_v3)
+export CAPTURE_BACKEND=${CAPTURE_BACKEND:-pcap}
+export TPACKET_BLOCK_SIZE=${TPACKET_BLOCK_SIZE:-4194304}
+export TPACKET_BLOCK_COUNT=${TPACKET_BLOCK_COUNT:-64}
+export TPACKET_RETIRE_TIMEOUT_MS=${TPACKET_RETIRE_TIMEOUT_MS:-60}
+
+# PACKET_FANOUT (hash | cpu | lb | qm, 비우면 단일 소켓)
+# hash 외의 모드는 flow가 여러 worker로 나뉘어 요청-응답 매칭/재조립을 신뢰할 수 없음
+export FANOUT_MODE=${FANOUT_MODE:-}
+export FANOUT_GROUP_ID=${FANOUT_GROUP_ID:-0}
+
+# 패킷이 없을 때 epoll 최대 대기 시간 (종료 신호는 즉시 깨움)
+export CAPTURE_POLL_TIMEOUT_MS=${CAPTURE_POLL_TIMEOUT_MS:-1000}
+
+# libpcap 캡처 튜닝 (커널 버퍼가 작으면 Modbus polling burst에서 드롭 발생)
+export PCAP_SNAPLEN=${PCAP_SNAPLEN:-65535}
+export PCAP_BUFFER_SIZE=${PCAP_BUFFER_SIZE:-33554432}
+export PCAP_IMMEDIATE=${PCAP_IMMEDIATE:-false}
+export PCAP_TSTAMP_PRECISION=${PCAP_TSTAMP_PRECISION:-micro}
+
+# 파서 목록으로 BPF 자동 생성 (BPF_FILTER와 함께 쓰면 AND로 결합)
+export AUTO_BPF_FILTER=${AUTO_BPF_FILTER:-false}
+export AUTO_BPF_PROTOCOLS=${AUTO_BPF_PROTOCOLS:-}
+export AUTO_BPF_KEEP_TCP_SESSION=${AUTO_BPF_KEEP_TCP_SESSION:-false}
+
+# 패킷 슬롯 풀 (슬롯 수 = 큐에 쌓일 수 있는 최대 패킷 수)
+export PACKET_POOL_SLOTS=${PACKET_POOL_SLOTS:-8192}
+export PACKET_POOL_SLOT_SIZE=${PACKET_POOL_SLOT_SIZE:-0}
+export PACKET_POOL_HUGEPAGES=${PACKET_POOL_HUGEPAGES:-false}
+
+# 스레드 배치 (역할=CPU 목록, ;로 구분) 예) capture=0;workers=2-5;es=1;redis=1
+export CPU_AFFINITY=${CPU_AFFINITY:-}
+
+# run-to-completion: 캡처 스레드에서 바로 파싱 (2코어 이하 엣지 장비용)
+export INLINE_PARSING=${INLINE_PARSING:-false}
+
+# 큐 한도/과부하 정책 (비우면 파일 입력은 block, 라이브 캡처는 drop_newest)
+export OVERLOAD_POLICY=${OVERLOAD_POLICY:-}
+export QUEUE_MAX_BYTES=${QUEUE_MAX_BYTES:-0}
+
+# 캡처 스레드 -> worker 배치 전달 (패킷 수 / 최대 대기 us)
+export HANDOFF_BATCH=${HANDOFF_BATCH:-32}
+export HANDOFF_TIMEOUT_US=${HANDOFF_TIMEOUT_US:-200}
+
+# decode 뒤 단계(enrich/serialize/sink) 스레드 수, 비우면 CPU 예산 기준
+export PIPELINE_STAGES=${PIPELINE_STAGES:-}
+export PIPELINE_BATCH=${PIPELINE_BATCH:-64}
+export PIPELINE_QUEUE_BATCHES=${PIPELINE_QUEUE_BATCHES:-32}
+
+# IPv4 조각 재조립 테이블 (메모리 한도 / 미완성 조각 보관 시간)
+export IP_FRAG_MAX_BYTES=${IP_FRAG_MAX_BYTES:-4194304}
+export IP_FRAG_TIMEOUT_SEC=${IP_FRAG_TIMEOUT_SEC:-30}
+
+# Modbus/S7/XGT TCP stream 재조립 (메모리 한도, 0이면 segment 단위 파싱 / idle stream 보관 시간)
+export TCP_STREAM_MAX_BYTES=${TCP_STREAM_MAX_BYTES:-8388608}
+export TCP_STREAM_TIMEOUT_SEC=${TCP_STREAM_TIMEOUT_SEC:-120}
+
 # Elasticsearch 설정
 export ELASTICSEARCH_HOST=${ELASTICSEARCH_HOST:-localhost}
 export ELASTICSEARCH_PORT=${ELASTICSEARCH_PORT:-9200}
@@ -34,7 +91,7 @@ export REDIS_PORT=${REDIS_PORT:-6379}
 export REDIS_PASSWORD=${REDIS_PASSWORD:-}
 export REDIS_DB=${REDIS_DB:-0}
 export REDIS_POOL_SIZE=${REDIS_POOL_SIZE:-8}
-export REDIS_ASYNC_WRITERS=${REDIS_ASYNC_WRITERS:-2}
+export REDIS_ASYNC_WRITERS=${REDIS_ASYNC_WRITERS:-0}
 export REDIS_ASYNC_QUEUE_SIZE=${REDIS_ASYNC_QUEUE_SIZE:-10000}
 export REDIS_TIMEOUT_MS=${REDIS_TIMEOUT_MS:-1000}
 
@@ -71,7 +128,11 @@ echo "  Network Interface: ${NETWORK_INTERFACE}"
 echo "  Mode: ${PARSER_MODE}"
 echo "  Output Directory: ${OUTPUT_DIR}"
 echo "  Rolling Interval: ${ROLLING_INTERVAL} minutes"
-echo "  Worker Threads: ${PARSER_THREADS} (0=auto)"
+echo "  Worker Threads: ${PARSER_THREADS} (0=auto from CPU limit)"
+echo "  Capture Backend: ${CAPTURE_BACKEND}"
+if [ ! -z "${FANOUT_MODE}" ]; then
+    echo "  Fanout: ${FANOUT_MODE} (group ${FANOUT_GROUP_ID})"
+fi
 echo ""
 echo "[Config] Elasticsearch:"
 echo "  Host: ${ELASTICSEARCH_HOST}:${ELASTICSEARCH_PORT}"
@@ -83,7 +144,7 @@ echo "[Config] Redis:"
 echo "  Host: ${REDIS_HOST}:${REDIS_PORT}"
 echo "  Database: ${REDIS_DB}"
 echo "  Pool Size: ${REDIS_POOL_SIZE}"
-echo "  Async Writers: ${REDIS_ASYNC_WRITERS}"
+echo "  Async Writers: ${REDIS_ASYNC_WRITERS} (0=auto)"
 echo ""
 echo "[Config] Command: ${CMD}"
 echo ""
@@ -61,13 +61,41 @@ std::string normalizeIp(const std::string& ip) {
             }
         }
     }
+    normalized = trim(normalized);
     
-    return trim(normalized);
+    // IPv4 옥텟 앞의 0 제거 (192.168.001.010 -> 192.168.1.10, inet_pton은 앞의 0을 거부함)
+    if (normalized.find(':') == std::string::npos) {
+        std::string stripped;
+        size_t start = 0;
+        while (start <= normalized.size()) {
+            size_t dot = normalized.find('.', start);
+            if (dot == std::string::npos) dot = normalized.size();
+            std::string octet = normalized.substr(start, dot - start);
+            size_t nonzero = octet.find_first_not_of('0');
+            if (nonzero == std::string::npos) {
+                octet = octet.empty() ? octet : "0";
+            } else {
+                octet = octet.substr(nonzero);
+            }
+            if (start > 0) stripped += '.';
+            stripped += octet;
+            start = dot + 1;
+        }
+        normalized = stripped;
+    }
+    
+    return normalized;
 }
 
 // IP 주소 유효성 검사
 bool isValidIp(const std::string& ip) {
     if (ip.empty()) return false;
+
+    // IPv6는 표기 형식이 다양하므로 inet_pton에 맡김
+    if (ip.find(':') != std::string::npos) {
+        IpAddress parsed;
+        return IpAddress::parse(ip, parsed);
+    }
     
     // 점이 정확히 3개 있어야 함
     int dot_count = std::count(ip.begin(), ip.end(), '.');
@@ -169,7 +197,13 @@ void AssetManager::loadIpCsv(const std::string& filepath) {
         }
         
         // 매핑 추가
-        ipDeviceMap[ip] = device_name;
+        IpAddress addr;
+        if (!IpAddress::parse(ip, addr)) {
+            std::cout << "[WARN] Line " << line_number << ": Could not parse IP '" 
+                     << ip_raw << "' (normalized: '" << ip << "'), skipping." << std::endl;
+            continue;
+        }
+        ipDeviceMap[addr] = device_name;
         last_device_name = device_name;
         
         std::cout << "[DEBUG] Mapped: " << ip << " -> " << device_name << std::endl;
@@ -217,6 +251,14 @@ void AssetManager::loadTagCsv(const std::string& filepath) {
 }
 
 std::string AssetManager::getDeviceName(const std::string& ip) const {
+    IpAddress addr;
+    if (!IpAddress::parse(ip, addr)) return "";
+    return getDeviceName(addr);
+}
+
+std::string AssetManager::getDeviceName(const IpAddress& ip) const {
+    // ARP 등 IP가 없는 패킷은 자산과 매칭하지 않음
+    if (ip.empty()) return "";
     auto it = ipDeviceMap.find(ip);
     if (it != ipDeviceMap.end()) {
         return it->second;
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include "network/ip_address.h"
 
 class AssetManager {
 public:
@@ -13,7 +14,8 @@ public:
                  const std::string& inputCsvPath, 
                  const std::string& outputCsvPath);
 
-    // IP 주소로 장치 이름을 찾습니다.
+    // IP 주소로 장치 이름을 찾습니다. (IPv4/IPv6)
+    std::string getDeviceName(const IpAddress& ip) const;
     std::string getDeviceName(const std::string& ip) const;
 
     // 변환된 주소(태그)로 'description' (내용)을 찾습니다.
@@ -33,8 +35,8 @@ private:
     void loadIpCsv(const std::string& filepath);
     void loadTagCsv(const std::string& filepath);
 
-    // 맵: IP -> 장치 이름
-    std::map<std::string, std::string> ipDeviceMap;
+    // 맵: IP -> 장치 이름 (바이너리 주소로 저장해서 IPv6 표기 차이와 무관하게 찾음)
+    std::map<IpAddress, std::string> ipDeviceMap;
     
     // 맵: 태그 주소 -> 설명 (description)
     std::map<std::string, std::string> tagDescriptionMap;
@@ -0,0 +1,181 @@
+#include "CpuBudget.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <vector>
+
+#ifndef _WIN32
+#include <sched.h>
+#endif
+
+namespace {
+
+// /proc/self/cgroup에서 controller의 경로 ("" = cgroup v2 unified)
+bool cgroupPath(const std::string& controller, std::string& path) {
+    std::ifstream in("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t first = line.find(':');
+        size_t second = line.find(':', first + 1);
+        if (first == std::string::npos || second == std::string::npos) continue;
+
+        std::string controllers = line.substr(first + 1, second - first - 1);
+        std::stringstream ss(controllers);
+        std::string name;
+        bool match = controller.empty() && controllers.empty();
+        while (!match && std::getline(ss, name, ',')) {
+            match = (name == controller);
+        }
+        if (match) {
+            path = line.substr(second + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool readLine(const std::string& path, std::string& value) {
+    std::ifstream in(path);
+    return in.is_open() && std::getline(in, value);
+}
+
+// cgroup 경로에서 루트까지 올라가며 디렉토리 목록을 만듦 (컨테이너 안에서는 보통 루트만 보임)
+std::vector<std::string> candidateDirs(const std::string& mount, std::string path) {
+    std::vector<std::string> dirs;
+    while (true) {
+        dirs.push_back(mount + (path == "/" ? "" : path));
+        if (path.empty() || path == "/") break;
+        size_t slash = path.find_last_of('/');
+        path = (slash == 0 || slash == std::string::npos) ? "/" : path.substr(0, slash);
+    }
+    return dirs;
+}
+
+// cgroup v2: cpu.max = "<quota|max> <period>", 계층 중 가장 작은 값
+bool readV2Quota(double& cpus, std::string& source) {
+    std::string path;
+    if (!cgroupPath("", path)) return false;
+
+    bool found = false;
+    for (const auto& dir : candidateDirs("/sys/fs/cgroup", path)) {
+        std::string value;
+        if (!readLine(dir + "/cpu.max", value)) continue;
+
+        std::stringstream ss(value);
+        std::string quota;
+        long long period = 0;
+        ss >> quota >> period;
+        if (quota == "max" || period <= 0) continue;
+
+        double limit = std::stod(quota) / static_cast<double>(period);
+        if (!found || limit < cpus) {
+            cpus = limit;
+            source = "cgroup v2 " + dir + "/cpu.max";
+            found = true;
+        }
+    }
+    return found;
+}
+
+// cgroup v1: cpu.cfs_quota_us / cpu.cfs_period_us (quota -1 = 제한 없음)
+bool readV1Quota(double& cpus, std::string& source) {
+    std::string path;
+    if (!cgroupPath("cpu", path)) return false;
+
+    bool found = false;
+    for (const char* mount : {"/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct"}) {
+        for (const auto& dir : candidateDirs(mount, path)) {
+            std::string quota_str, period_str;
+            if (!readLine(dir + "/cpu.cfs_quota_us", quota_str) ||
+                !readLine(dir + "/cpu.cfs_period_us", period_str)) {
+                continue;
+            }
+
+            long long quota = std::stoll(quota_str);
+            long long period = std::stoll(period_str);
+            if (quota <= 0 || period <= 0) continue;
+
+            double limit = static_cast<double>(quota) / static_cast<double>(period);
+            if (!found || limit < cpus) {
+                cpus = limit;
+                source = "cgroup v1 " + dir + "/cpu.cfs_quota_us";
+                found = true;
+            }
+        }
+        if (found) break;
+    }
+    return found;
+}
+
+} // namespace
+
+CpuBudget CpuBudget::detect() {
+    CpuBudget budget;
+    budget.hardware_cpus = std::max(1u, std::thread::hardware_concurrency());
+
+#ifndef _WIN32
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        budget.cpuset_cpus = CPU_COUNT(&mask);
+    }
+
+    try {
+        if (!readV2Quota(budget.quota_cpus, budget.quota_source)) {
+            readV1Quota(budget.quota_cpus, budget.quota_source);
+        }
+    } catch (const std::exception&) {
+        budget.quota_cpus = 0.0;
+        budget.quota_source.clear();
+    }
+#endif
+
+    int cpus = budget.hardware_cpus;
+    if (budget.cpuset_cpus > 0) cpus = std::min(cpus, budget.cpuset_cpus);
+    if (budget.quota_cpus > 0) {
+        // 1.5 CPU quota면 스레드 2개가 나눠 쓸 수 있음
+        cpus = std::min(cpus, static_cast<int>(std::ceil(budget.quota_cpus - 0.01)));
+    }
+    budget.cpus = std::max(1, cpus);
+    return budget;
+}
+
+std::string CpuBudget::describe() const {
+    std::ostringstream out;
+    out << cpus << " CPUs (hardware " << hardware_cpus;
+    if (cpuset_cpus > 0) out << ", cpuset " << cpuset_cpus;
+    if (quota_cpus > 0) {
+        out << ", quota " << std::fixed;
+        out.precision(2);
+        out << quota_cpus << " from " << quota_source;
+    } else {
+        out << ", no CPU quota";
+    }
+    out << ")";
+    return out.str();
+}
+
+ThreadPlan ThreadPlan::fromBudget(const CpuBudget& budget, bool realtime, bool fanout) {
+    ThreadPlan plan;
+    plan.capture = fanout ? 0 : 1;
+    int remaining = budget.cpus - plan.capture;
+
+    if (realtime) {
+        // ES flush/Redis writer는 대부분 I/O 대기라 예산 4개당 1개 정도만 떼어 둠
+        plan.sink = std::max(1, std::min(4, budget.cpus / 4));
+        if (budget.cpus >= 4) remaining -= plan.sink;
+    }
+
+    plan.workers = std::max(1, std::min(8, remaining));
+
+    std::ostringstream reason;
+    if (plan.capture > 0) reason << "capture " << plan.capture << " + ";
+    reason << "workers " << plan.workers;
+    if (realtime) reason << " + sink " << plan.sink;
+    reason << " on " << budget.cpus << " CPUs";
+    if (budget.cpus <= 2) reason << " (consider --inline for edge boxes)";
+    plan.reason = reason.str();
+    return plan;
+}
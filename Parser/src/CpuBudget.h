@@ -0,0 +1,29 @@
+#ifndef CPU_BUDGET_H
+#define CPU_BUDGET_H
+
+#include <string>
+
+// 컨테이너가 실제로 쓸 수 있는 CPU 수 (cgroup quota, cpuset, 하드웨어 중 가장 작은 값)
+struct CpuBudget {
+    int hardware_cpus = 1;      // std::thread::hardware_concurrency()
+    int cpuset_cpus = 0;        // sched_getaffinity (cpuset 반영), 0 = 알 수 없음
+    double quota_cpus = 0.0;    // cgroup CPU quota / period, 0 = 제한 없음
+    std::string quota_source;   // 예) "cgroup v2 /sys/fs/cgroup/cpu.max"
+    int cpus = 1;               // 최종 예산 (정수, 최소 1)
+
+    static CpuBudget detect();
+    std::string describe() const;
+};
+
+// 예산을 캡처 / 파싱 worker / sink(ES, Redis writer)로 나눈 결과
+struct ThreadPlan {
+    int capture = 1;        // fanout 모드에서는 worker가 캡처까지 하므로 0
+    int workers = 1;
+    int sink = 0;           // Redis async writer 수 (realtime 모드)
+    std::string reason;
+
+    // realtime이면 ES/Redis sink 몫을 따로 떼어 둠, worker는 기존과 같이 최대 8개
+    static ThreadPlan fromBudget(const CpuBudget& budget, bool realtime, bool fanout = false);
+};
+
+#endif // CPU_BUDGET_H
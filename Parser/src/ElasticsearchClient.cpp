@@ -1,4 +1,5 @@
 #include "ElasticsearchClient.h"
+#include "ThreadPlacement.h"
 #include <iostream>
 #include <sstream>
 #include <ctime>
@@ -279,6 +280,7 @@ bool ElasticsearchClient::flushBulk() {
 }
 
 void ElasticsearchClient::autoFlushLoop() {
+    ThreadPlacement::apply(ThreadRole::ELASTICSEARCH);
     std::cout << "[Elasticsearch] Auto-flush thread started (interval: "
               << m_config.flush_interval_ms << "ms)" << std::endl;
 
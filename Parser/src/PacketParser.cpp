@@ -1,5 +1,11 @@
 #include "PacketParser.h"
 #include "./network/network_headers.h"
+#include "./network/link_layer.h"
+#include "./network/flow_hash.h"
+#include "./network/packet_decoder.h"
+#include "./capture/CaptureEventLoop.h"
+#include "ThreadPlacement.h"
+#include "CpuBudget.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -27,30 +33,28 @@
 #include "./protocols/ArpParser.h"
 #include "./protocols/TcpSessionParser.h"
 
-static std::string mac_to_string_helper(const uint8_t* mac) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (int i = 0; i < 6; ++i) {
-        ss << std::setw(2) << static_cast<int>(mac[i]) << (i < 5 ? ":" : "");
-    }
-    return ss.str();
+bool parseOverloadPolicy(const std::string& name, OverloadPolicy& policy) {
+    if (name == "block") policy = OVERLOAD_BLOCK;
+    else if (name == "drop_newest") policy = OVERLOAD_DROP_NEWEST;
+    else if (name == "drop_oldest") policy = OVERLOAD_DROP_OLDEST;
+    else if (name == "shed_low_priority") policy = OVERLOAD_SHED_LOW_PRIORITY;
+    else return false;
+    return true;
 }
 
-static std::string format_timestamp(const struct timeval& ts) {
-    char buf[sizeof "2011-10-08T07:07:09.000000Z"];
-    char buft[sizeof "2011-10-08T07:07:09"];
-    time_t sec = ts.tv_sec;
-    struct tm gmt;
-
-    #ifdef _WIN32
-        gmtime_s(&gmt, &sec);
-    #else
-        gmtime_r(&sec, &gmt);
-    #endif
+const char* overloadPolicyName(OverloadPolicy policy) {
+    switch (policy) {
+        case OVERLOAD_BLOCK: return "block";
+        case OVERLOAD_DROP_NEWEST: return "drop_newest";
+        case OVERLOAD_DROP_OLDEST: return "drop_oldest";
+        case OVERLOAD_SHED_LOW_PRIORITY: return "shed_low_priority";
+    }
+    return "unknown";
+}
 
-    strftime(buft, sizeof buft, "%Y-%m-%dT%H:%M:%S", &gmt);
-    snprintf(buf, sizeof buf, "%.*s.%06dZ", (int)sizeof(buft) - 1, buft, (int)ts.tv_usec);
-    return std::string(buf);
+const char* dropReasonName(int reason) {
+    static const char* names[DROP_REASON_COUNT] = {"queue_full", "evicted", "shed"};
+    return (reason >= 0 && reason < DROP_REASON_COUNT) ? names[reason] : "unknown";
 }
 
 PacketParser::PacketParser(const std::string& output_dir, 
@@ -81,14 +85,21 @@ PacketParser::PacketParser(const std::string& output_dir,
 
     // 스레드 수 결정
     if (num_threads <= 0) {
-        unsigned int hw_threads = std::thread::hardware_concurrency();
-        m_num_threads = std::max(1u, std::min(8u, hw_threads / 2));
+        // main이 예산을 정하지 않고 호출한 경우: cgroup quota/cpuset 기준으로 결정
+        m_num_threads = ThreadPlan::fromBudget(CpuBudget::detect(), disable_file_output).workers;
     } else {
         m_num_threads = std::min(num_threads, 16);
     }
     
     std::cout << "[INFO] Using " << m_num_threads << " worker threads" << std::endl;
 
+    // reader가 worker보다 너무 앞서 가지 않도록 worker당 chunk 2개까지만 대기
+    for (int i = 0; i < m_num_threads; ++i) {
+        m_worker_queues.push_back(std::make_unique<WorkerQueue>());
+        m_worker_queues.back()->chunks.init(2);
+        m_worker_queues.back()->pending.reserve(m_handoff_batch);
+    }
+
     // UnifiedWriter 초기화 (파일 출력이 필요한 경우만)
     if (!m_disable_file_output) {
         m_unified_writer = std::make_unique<UnifiedWriter>(m_output_dir, m_time_interval);
@@ -120,11 +131,20 @@ PacketParser::PacketParser(const std::string& output_dir,
         }
     }
 
+    m_pipeline.setSinks(m_unified_writer.get(),
+                        m_use_redis ? m_redis_cache.get() : nullptr,
+                        m_use_elasticsearch ? m_elasticsearch.get() : nullptr);
+    m_pipeline.configure(PipelineConfig(), m_num_threads);
+
     // 워커별 파서 생성
     m_worker_parsers.resize(m_num_threads);
     for (int i = 0; i < m_num_threads; ++i) {
         createParsersForWorker(i);
+        m_reassemblers.push_back(std::make_unique<Ipv4Reassembler>());
+        m_tcp_streams.push_back(std::make_unique<TcpStreamReassembler>());
     }
+    setReassemblyConfig(ReassemblyConfig());
+    setTcpStreamConfig(TcpStreamConfig());
 }
 
 void PacketParser::createParsersForWorker(int worker_id) {
@@ -150,30 +170,14 @@ void PacketParser::createParsersForWorker(int worker_id) {
         parser->setAssetManager(&m_assetManager);
     }
 
-    // 파일 출력이 활성화된 경우만 UnifiedWriter 설정
-    if (!m_disable_file_output && m_unified_writer) {
-        for (const auto& parser : parsers) {
-            parser->setUnifiedWriter(m_unified_writer.get());
-        }
-
-        // 첫 번째 워커만 백엔드 콜백 설정
-        if (worker_id == 0) {
-            m_unified_writer->setBackendCallback(
-                [this](const UnifiedRecord& record) {
-                    this->sendToBackends(record);
-                }
-            );
-        }
-    } else {
-        // 파일 출력 없이 직접 백엔드로 전송
-        for (const auto& parser : parsers) {
-            // DummyWriter를 설정하거나 직접 콜백 설정
-            parser->setDirectBackendCallback(
-                [this](const UnifiedRecord& record) {
-                    this->sendToBackends(record);
-                }
-            );
-        }
+    // 레코드는 파일/백엔드로 바로 쓰지 않고 파이프라인의 worker 배치에 모음
+    // (UnifiedWriter와 ES/Redis 전송은 sink 단계에서 처리)
+    for (const auto& parser : parsers) {
+        parser->setDirectBackendCallback(
+            [this, worker_id](const UnifiedRecord& record) {
+                m_pipeline.emit(worker_id, record);
+            }
+        );
     }
 }
 
@@ -193,158 +197,35 @@ PacketParser::~PacketParser() {
     std::cout << "[INFO] PacketParser cleanup complete" << std::endl;
 }
 
-void PacketParser::sendToBackends(const UnifiedRecord& record) {
-    try {
-        // Elasticsearch로 즉시 전송 (기존과 동일)
-        if (m_use_elasticsearch && m_elasticsearch->isConnected()) {
-            json es_doc;
-            es_doc["@timestamp"] = record.timestamp;
-            es_doc["protocol"] = record.protocol;
-            es_doc["src_ip"] = record.sip;
-            es_doc["dst_ip"] = record.dip;
-            
-            // 포트 파싱
-            try {
-                es_doc["src_port"] = record.sp.empty() ? 0 : std::stoi(record.sp);
-                es_doc["dst_port"] = record.dp.empty() ? 0 : std::stoi(record.dp);
-            } catch (const std::exception& e) {
-                std::cerr << "[WARN] Port parsing error: " << e.what() << std::endl;
-                es_doc["src_port"] = 0;
-                es_doc["dst_port"] = 0;
-            }
-            
-            es_doc["src_mac"] = record.smac;
-            es_doc["dst_mac"] = record.dmac;
-            es_doc["direction"] = record.dir;
-            
-            // protocol_details 파싱 (details_json이 있는 경우만)
-            if (!record.details_json.empty()) {
-                try {
-                    es_doc["protocol_details"] = json::parse(record.details_json);
-                } catch (const std::exception& e) {
-                    std::cerr << "[WARN] JSON parsing error: " << e.what() << std::endl;
-                    es_doc["protocol_details"] = json::object();
-                }
-            } else {
-                es_doc["protocol_details"] = json::object();
-            }
-            
-            // 프로토콜별 중요 필드 추출 (기존과 동일)
-            if (record.protocol == "modbus") {
-                if (!record.modbus_fc.empty()) es_doc["modbus_function"] = record.modbus_fc;
-                if (!record.modbus_addr.empty()) es_doc["modbus_address"] = record.modbus_addr;
-                if (!record.modbus_description.empty()) es_doc["description"] = record.modbus_description;
-            } else if (record.protocol == "s7comm") {
-                if (!record.s7_fn.empty()) es_doc["s7_function"] = record.s7_fn;
-                if (!record.s7_description.empty()) es_doc["description"] = record.s7_description;
-            } else if (record.protocol == "xgt_fen") {
-                if (!record.xgt_cmd.empty()) es_doc["xgt_command"] = record.xgt_cmd;
-                if (!record.xgt_description.empty()) es_doc["description"] = record.xgt_description;
-            }
-            
-            // 자산 정보 추가 (기존과 동일)
-            if (m_use_redis && m_redis_cache->isConnected()) {
-                AssetInfo src_asset = m_redis_cache->getAssetInfo(record.sip);
-                AssetInfo dst_asset = m_redis_cache->getAssetInfo(record.dip);
-                
-                if (!src_asset.asset_id.empty()) {
-                    es_doc["src_asset"] = src_asset.toJson();
-                }
-                if (!dst_asset.asset_id.empty()) {
-                    es_doc["dst_asset"] = dst_asset.toJson();
-                }
-            }
-            
-            if (m_elasticsearch->addToBulk(record.protocol, es_doc)) {
-                // 1000개마다 한번씩 로그 출력
-                static std::atomic<int> es_add_count{0};
-                int count = ++es_add_count;
-                if (count % 1000 == 0) {
-                    std::cout << "[Elasticsearch] ✓ Queued " << count << " documents to bulk" << std::endl;
-                }
-            } else {
-                std::cerr << "[WARN] Failed to add to Elasticsearch bulk" << std::endl;
-            }
-        }
-        
-        // ★ Redis Stream으로 전송 - 프로토콜명을 키로 사용
-        if (m_use_redis && m_redis_cache->isConnected()) {
-            ParsedPacketData redis_data;
-            redis_data.timestamp = record.timestamp;
-            redis_data.protocol = record.protocol;
-
-            // JSONL 형식과 동일한 짧은 필드명 사용
-            redis_data.smac = record.smac;
-            redis_data.dmac = record.dmac;
-            redis_data.sip = record.sip;
-            redis_data.sp = record.sp;
-            redis_data.dip = record.dip;
-            redis_data.dp = record.dp;
-            redis_data.sq = record.sq;
-            redis_data.ak = record.ak;
-            redis_data.fl = record.fl;
-            redis_data.dir = record.dir;
-
-            // 자산 정보 추가
-            redis_data.src_asset_id = record.src_asset_id;
-            redis_data.src_asset_name = record.src_asset_name;
-            redis_data.src_asset_group = record.src_asset_group;
-            redis_data.src_asset_location = record.src_asset_location;
-            redis_data.dst_asset_id = record.dst_asset_id;
-            redis_data.dst_asset_name = record.dst_asset_name;
-            redis_data.dst_asset_group = record.dst_asset_group;
-            redis_data.dst_asset_location = record.dst_asset_location;
-
-            // protocol_details 파싱 (details_json이 있는 경우만)
-            if (!record.details_json.empty()) {
-                try {
-                    redis_data.protocol_details = json::parse(record.details_json);
-                } catch (const std::exception& e) {
-                    redis_data.protocol_details = json::object();
-                }
-            } else {
-                redis_data.protocol_details = json::object();
-            }
-
-            std::string stream_name = RedisKeys::protocolStream(record.protocol);
-            if (m_redis_cache->pushToStream(stream_name, redis_data)) {
-                // 1000개마다 한번씩 로그 출력
-                static std::atomic<int> redis_success_count{0};
-                int count = ++redis_success_count;
-                if (count % 1000 == 0) {
-                    std::cout << "[Redis] ✓ Sent " << count << " records to streams" << std::endl;
-                }
-            } else {
-                std::cerr << "[WARN] Failed to push to Redis stream: " << stream_name << std::endl;
-            }
+void PacketParser::startWorkers() {
+    if (m_inline) {
+        std::cout << "[INFO] Run-to-completion mode: packets are parsed on the capture thread" << std::endl;
+    } else {
+        std::cout << "[INFO] Starting " << m_num_threads << " worker threads..." << std::endl;
+        for (int i = 0; i < m_num_threads; ++i) {
+            m_workers.emplace_back(&PacketParser::workerThread, this, i);
         }
-    } catch (const std::exception& e) {
-        std::cerr << "[ERROR] sendToBackends exception: " << e.what() << std::endl;
     }
-}
 
-void PacketParser::startWorkers() {
-    std::cout << "[INFO] Starting " << m_num_threads << " worker threads..." << std::endl;
-    
-    for (int i = 0; i < m_num_threads; ++i) {
-        m_workers.emplace_back(&PacketParser::workerThread, this, i);
-    }
+    std::cout << "[INFO] Record pipeline: " << m_pipeline.getConfig().describe() << std::endl;
+    m_pipeline.start();
     
     // Elasticsearch 실시간 flush 스레드
     if (m_use_elasticsearch) {
-        m_workers.emplace_back(&PacketParser::realtimeFlushThread, this);
+        m_flush_thread = std::thread(&PacketParser::realtimeFlushThread, this);
     }
     
     std::cout << "[INFO] Worker threads started" << std::endl;
 }
 
 void PacketParser::realtimeFlushThread() {
+    ThreadPlacement::apply(ThreadRole::FLUSH);
     std::cout << "[INFO] Realtime flush thread started" << std::endl;
     
     auto last_flush = std::chrono::steady_clock::now();
     const auto flush_interval = std::chrono::milliseconds(100);  // 100ms마다 체크
     
-    while (!m_stop_flag.load()) {
+    while (!m_flush_stop.load()) {
         std::this_thread::sleep_for(flush_interval);
         
         auto now = std::chrono::steady_clock::now();
@@ -369,12 +250,26 @@ void PacketParser::realtimeFlushThread() {
 
 
 void PacketParser::stopWorkers() {
-    if (m_workers.empty()) return;
+    if (m_workers.empty() && !m_flush_thread.joinable() && !m_pipeline.isStarted()) return;
     
     std::cout << "[INFO] Stopping worker threads..." << std::endl;
     
+    // 아직 publish하지 않은 배치의 lease가 반환되지 않는 일이 없도록 먼저 넘김
+    flushHandoff();
     m_stop_flag = true;
-    m_queue_cv.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_chunk_space_cv.notify_all();
+        m_slot_cv.notify_all();
+    }
+    for (auto& queue : m_worker_queues) {
+        std::lock_guard<std::mutex> lock(queue->doorbell_mutex);
+        queue->doorbell.notify_all();
+    }
+    if (!m_worker_backends.empty()) {
+        // epoll에서 대기 중인 캡처 worker를 깨움
+        CaptureEventLoop::requestShutdown();
+    }
     
     for (auto& worker : m_workers) {
         if (worker.joinable()) {
@@ -383,18 +278,26 @@ void PacketParser::stopWorkers() {
     }
     
     m_workers.clear();
+
+    // decode가 끝났으므로 남은 레코드 배치를 sink까지 비우고, 그 뒤에 마지막 ES flush
+    m_pipeline.stop();
+    m_flush_stop = true;
+    if (m_flush_thread.joinable()) {
+        m_flush_thread.join();
+    }
+
+    // 모든 lease가 반환된 뒤에 소켓/ring 해제
+    m_worker_backends.clear();
     std::cout << "[INFO] Worker threads stopped" << std::endl;
 }
 
 void PacketParser::waitForCompletion() {
     std::cout << "[INFO] Waiting for queue to empty..." << std::endl;
+    flushHandoff();
     
     while (true) {
-        {
-            std::lock_guard<std::mutex> lock(m_queue_mutex);
-            if (m_packet_queue.empty()) {
-                break;
-            }
+        if (workerQueuesEmpty() && m_pipeline.isIdle()) {
+            break;
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
@@ -411,30 +314,179 @@ void PacketParser::waitForCompletion() {
     std::cout << "[INFO] All packets processed" << std::endl;
 }
 
+std::string PacketParser::buildCaptureFilter(const std::vector<std::string>& allow_list, bool keep_tcp_session,
+                                             bool include_vlan) const {
+    if (m_worker_parsers.empty()) return "";
+
+    std::vector<std::string> clauses;
+    for (const auto& parser : m_worker_parsers[0]) {
+        const std::string name = parser->getName();
+        if (name == "tcp_session" && !keep_tcp_session) continue;
+        if (!allow_list.empty() && name != "tcp_session" &&
+            std::find(allow_list.begin(), allow_list.end(), name) == allow_list.end()) {
+            continue;
+        }
+
+        std::string clause = parser->getCaptureFilter();
+        if (clause.empty()) continue;
+
+        clause = "(" + clause + ")";
+        if (std::find(clauses.begin(), clauses.end(), clause) == clauses.end()) {
+            clauses.push_back(clause);
+        }
+    }
+
+    for (const auto& name : allow_list) {
+        bool known = false;
+        for (const auto& parser : m_worker_parsers[0]) {
+            if (parser->getName() == name) known = true;
+        }
+        if (!known) {
+            std::cerr << "[WARN] Unknown parser in auto filter allow-list: " << name << std::endl;
+        }
+    }
+
+    std::string filter;
+    bool has_port_clause = false;
+    for (const auto& clause : clauses) {
+        if (!filter.empty()) filter += " or ";
+        filter += clause;
+        has_port_clause = has_port_clause || clause.find("port") != std::string::npos;
+    }
+
+    // "port"는 offset 0인 조각에서만 참이므로 두 번째 이후 IPv4 조각도 통과시켜 재조립되게 함
+    if (has_port_clause) {
+        filter += " or (ip[6:2] & 0x1fff != 0)";
+    }
+
+    // "vlan"은 식의 나머지 부분의 오프셋을 4바이트 옮기므로 태그 없는 식을 먼저 두고,
+    // QinQ는 첫 "vlan" 안쪽에 중첩 (F or (vlan and (F or (vlan and (F)))))
+    if (include_vlan && !filter.empty()) {
+        filter = filter + " or (vlan and (" + filter + " or (vlan and (" + filter + "))))";
+    }
+    return filter;
+}
+
+void PacketParser::attachWorkerBackends(std::vector<std::unique_ptr<ICaptureBackend>> backends, int poll_timeout_ms) {
+    m_worker_backends = std::move(backends);
+    m_capture_poll_timeout_ms = poll_timeout_ms;
+    if (!m_worker_backends.empty()) {
+        m_datalink = m_worker_backends[0]->getDatalink();
+    }
+    std::cout << "[INFO] " << m_worker_backends.size() << " workers capture from their own sockets" << std::endl;
+}
+
+bool PacketParser::getCaptureStats(CaptureStats& stats) {
+    if (m_worker_backends.empty()) return false;
+
+    stats = CaptureStats();
+    for (auto& backend : m_worker_backends) {
+        CaptureStats backend_stats;
+        if (backend && backend->getStats(backend_stats)) {
+            stats.packets_received += backend_stats.packets_received;
+            stats.packets_dropped += backend_stats.packets_dropped;
+            stats.ring_freezes += backend_stats.ring_freezes;
+        }
+    }
+    return true;
+}
+
+void PacketParser::workerPacketCallback(u_char* user, const struct pcap_pkthdr* header,
+                                        const u_char* packet, PacketLease* lease) {
+    WorkerCaptureContext* ctx = reinterpret_cast<WorkerCaptureContext*>(user);
+
+    // 자기 소켓의 ring 블록을 그 자리에서 파싱하므로 큐/복사 없음
+    ctx->parser->parsePacket(header, packet, ctx->parser->m_datalink, ctx->worker_id);
+    ctx->parser->m_pipeline.endPacket(ctx->worker_id);
+    if (lease) {
+        lease->release();
+    }
+    ctx->parser->m_packets_processed++;
+}
+
+void PacketParser::captureWorkerLoop(int worker_id) {
+    ICaptureBackend* backend = m_worker_backends[worker_id].get();
+    WorkerCaptureContext ctx{this, worker_id};
+
+    CaptureEventLoop event_loop(m_capture_poll_timeout_ms);
+    if (!event_loop.open(backend->getSelectableFd())) {
+        std::cerr << "[ERROR] Worker " << worker_id << " could not start capture event loop" << std::endl;
+        return;
+    }
+
+    while (!m_stop_flag.load()) {
+        int result = backend->dispatch(-1, workerPacketCallback, reinterpret_cast<u_char*>(&ctx));
+        if (result < 0) {
+            std::cerr << "[ERROR] Worker " << worker_id << " capture failed" << std::endl;
+            break;
+        }
+        if (result == 0) {
+            m_pipeline.flush(worker_id);
+            CaptureEventLoop::WaitResult wait_result = event_loop.wait();
+            if (wait_result == CaptureEventLoop::SHUTDOWN || wait_result == CaptureEventLoop::WAIT_ERROR) {
+                break;
+            }
+        }
+    }
+}
+
 void PacketParser::workerThread(int worker_id) {
+    ThreadPlacement::apply(ThreadRole::WORKER, worker_id);
+
+    if (static_cast<size_t>(worker_id) < m_worker_backends.size() && m_worker_backends[worker_id]) {
+        captureWorkerLoop(worker_id);
+        return;
+    }
+
+    WorkerQueue& queue = *m_worker_queues[worker_id];
+
     while (true) {
-        std::shared_ptr<PacketData> packet_data;
-        
-        {
-            std::unique_lock<std::mutex> lock(m_queue_mutex);
-            m_queue_cv.wait(lock, [this] { 
-                return m_stop_flag.load() || !m_packet_queue.empty(); 
-            });
-            
-            if (m_stop_flag.load() && m_packet_queue.empty()) {
-                break;
+        bool worked = false;
+
+        std::shared_ptr<OfflineChunk> chunk;
+        if (queue.chunks.pop(chunk)) {
+            {
+                std::lock_guard<std::mutex> lock(m_queue_mutex);
             }
-            
-            if (!m_packet_queue.empty()) {
-                packet_data = m_packet_queue.front();
-                m_packet_queue.pop();
+            m_chunk_space_cv.notify_one();
+
+            for (const OfflinePacket& packet : *chunk) {
+                parsePacket(&packet.header, packet.data, packet.linktype, worker_id);
+                m_pipeline.endPacket(worker_id);
             }
+            m_packets_processed += chunk->size();
+            worked = true;
         }
-        
-        if (packet_data) {
-            parsePacket(&packet_data->header, packet_data->packet.data(), worker_id);
+
+        PacketSlot* slot = nullptr;
+        while (queue.packets.pop(slot)) {
+            parsePacket(&slot->header, slot->data, m_datalink, worker_id);
+            m_pipeline.endPacket(worker_id);
+            if (slot->lease) {
+                slot->lease->release();
+            }
+            releaseSlot(slot);
             m_packets_processed++;
+            worked = true;
+        }
+
+        if (worked) continue;
+
+        // 큐가 비었으면 모아 둔 레코드를 기다리게 두지 않음
+        m_pipeline.flush(worker_id);
+
+        if (m_stop_flag.load() && queue.packets.empty() && queue.chunks.empty()) {
+            break;
         }
+
+        // 큐가 비었으면 doorbell을 기다림 (캡처 스레드는 sleeping일 때만 깨움)
+        std::unique_lock<std::mutex> lock(queue.doorbell_mutex);
+        queue.sleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        queue.doorbell.wait(lock, [this, &queue] {
+            return m_stop_flag.load() || !queue.packets.empty() || !queue.chunks.empty();
+        });
+        queue.sleeping.store(false);
     }
 }
 
@@ -449,50 +501,351 @@ void PacketParser::generateUnifiedOutput() {
     std::cout << "[INFO] Unified output generation complete" << std::endl;
 }
 
-std::string PacketParser::get_canonical_flow_id(const std::string& ip1_str, uint16_t port1, const std::string& ip2_str, uint16_t port2) {
-    std::string ip1 = ip1_str, ip2 = ip2_str;
-    if (ip1 > ip2 || (ip1 == ip2 && port1 > port2)) {
-        std::swap(ip1, ip2);
-        std::swap(port1, port2);
+bool PacketParser::initPacketPool(const PacketPoolConfig& config, int snaplen) {
+    if (!m_pool.open(config, snaplen)) {
+        return false;
     }
-    return ip1 + ":" + std::to_string(port1) + "-" + ip2 + ":" + std::to_string(port2);
+    for (auto& queue : m_worker_queues) {
+        queue->packets.init(m_pool.getSlotCount());
+    }
+    return true;
 }
 
-void PacketParser::parse(const struct pcap_pkthdr* header, const u_char* packet) {
-    auto packet_data = std::make_shared<PacketData>(header, packet);
-    
-    {
+void PacketParser::releaseSlot(PacketSlot* slot) {
+    m_queued_bytes -= slot->header.caplen;
+    m_pool.release(slot);
+    if (m_pool_waiting.load()) {
         std::lock_guard<std::mutex> lock(m_queue_mutex);
-        m_packet_queue.push(packet_data);
+        m_slot_cv.notify_one();
+    }
+}
+
+void PacketParser::setOverloadPolicy(OverloadPolicy policy, size_t max_bytes) {
+    m_overload_policy = policy;
+    m_queue_max_bytes = max_bytes;
+}
+
+bool PacketParser::hasByteRoom(uint32_t caplen) const {
+    return m_queue_max_bytes == 0 || m_queued_bytes.load() + caplen <= m_queue_max_bytes;
+}
+
+bool PacketParser::aboveShedMark(uint32_t caplen) const {
+    size_t backlog = m_packets_queued.load() - m_packets_processed.load();
+    if (backlog >= m_pool.getSlotCount() / 4 * 3) return true;
+    return m_queue_max_bytes > 0 && m_queued_bytes.load() + caplen > m_queue_max_bytes / 4 * 3;
+}
+
+PacketSlot* PacketParser::admitPacket(const FlowHint& hint, uint32_t caplen) {
+    if (m_overload_policy == OVERLOAD_SHED_LOW_PRIORITY &&
+        isLowPriorityTraffic(hint.traffic_class) && aboveShedMark(caplen)) {
+        m_overload_stats.drops[DROP_SHED][hint.traffic_class]++;
+        return nullptr;
+    }
+
+    PacketSlot* slot = hasByteRoom(caplen) ? m_pool.acquire() : nullptr;
+    if (slot) return slot;
+
+    if (m_overload_policy == OVERLOAD_BLOCK && m_pool.isOpen()) {
+        // worker가 슬롯을 반환할 때까지 대기 (패킷 유실 없음)
+        // 모아 둔 배치가 풀을 잡고 있으면 worker가 반환할 슬롯이 없으므로 먼저 publish
+        flushHandoff();
+        m_overload_stats.blocked++;
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        m_pool_waiting = true;
+        m_slot_cv.wait(lock, [this, &slot, caplen] {
+            return m_stop_flag.load() || (hasByteRoom(caplen) && (slot = m_pool.acquire()) != nullptr);
+        });
+        m_pool_waiting = false;
+        if (slot) return slot;
+    } else if (m_overload_policy == OVERLOAD_DROP_OLDEST) {
+        slot = evictOldest(caplen);
+        if (slot) return slot;
+    }
+
+    m_overload_stats.drops[DROP_QUEUE_FULL][hint.traffic_class]++;
+    return nullptr;
+}
+
+PacketSlot* PacketParser::evictOldest(uint32_t caplen) {
+    // 아직 publish하지 않은 배치도 ring으로 옮겨야 빼앗을 수 있음
+    flushHandoff();
+
+    PacketSlot* slot = m_pool.acquire();
+    while (!slot || !hasByteRoom(caplen)) {
+        // 가장 많이 밀린 worker의 맨 앞 패킷을 버림
+        WorkerQueue* victim = nullptr;
+        size_t longest = 0;
+        for (auto& queue : m_worker_queues) {
+            size_t backlog = queue->packets.size();
+            if (backlog > longest) {
+                longest = backlog;
+                victim = queue.get();
+            }
+        }
+
+        PacketSlot* oldest = nullptr;
+        if (!victim || !victim->packets.steal(oldest)) {
+            if (!victim) {
+                if (slot) m_pool.release(slot);
+                return nullptr;
+            }
+            continue;  // worker가 먼저 가져감
+        }
+
+        m_overload_stats.drops[DROP_EVICTED][oldest->traffic_class]++;
+        if (oldest->lease) {
+            oldest->lease->release();
+        }
+        m_packets_processed++;
+
+        if (!slot) {
+            m_queued_bytes -= oldest->header.caplen;
+            slot = oldest;
+        } else {
+            releaseSlot(oldest);
+        }
+    }
+    return slot;
+}
+
+void PacketParser::parse(const struct pcap_pkthdr* header, const u_char* packet, PacketLease* lease) {
+    if (m_inline) {
+        // 캡처 버퍼를 그대로 파싱 (pcap 버퍼는 콜백 동안, ring 블록은 release 전까지 유효)
         m_packets_queued++;
+        parsePacket(header, packet, m_datalink, 0);
+        m_pipeline.endPacket(0);
+        if (lease) {
+            lease->release();
+        }
+        m_packets_processed++;
+        return;
     }
+
+    FlowHint hint = computeFlowHint(m_datalink, packet, header->caplen);
+    PacketSlot* slot = admitPacket(hint, header->caplen);
+    if (!slot) {
+        if (lease) {
+            lease->release();
+        }
+        return;
+    }
+
+    if (lease) {
+        slot->header = *header;
+        slot->data = packet;
+        slot->lease = lease;
+    } else {
+        m_pool.copyInto(slot, header, packet);
+    }
+    slot->traffic_class = hint.traffic_class;
+    m_queued_bytes += header->caplen;
     
-    m_queue_cv.notify_one();
+    WorkerQueue& queue = *m_worker_queues[selectWorker(hint.hash)];
+    m_packets_queued++;
+    queue.pending.push_back(slot);
+
+    if (queue.pending.size() >= m_handoff_batch) {
+        publishPending(queue, PUBLISH_FULL);
+        return;
+    }
+
+    // 배치가 다 차지 않아도 가장 오래된 패킷이 timeout을 넘기면 publish
+    auto now = std::chrono::steady_clock::now();
+    if (queue.pending.size() == 1) {
+        queue.pending_since = now;
+        m_handoff_deadline = std::min(m_handoff_deadline, now + m_handoff_timeout);
+    }
+    if (now >= m_handoff_deadline) {
+        publishExpired(now);
+    }
+}
+
+void PacketParser::setHandoffBatch(size_t batch_size, int timeout_us) {
+    m_handoff_batch = std::max<size_t>(1, batch_size);
+    m_handoff_timeout = std::chrono::microseconds(std::max(0, timeout_us));
+    for (auto& queue : m_worker_queues) {
+        queue->pending.reserve(m_handoff_batch);
+    }
+}
+
+void PacketParser::publishPending(WorkerQueue& queue, PublishReason reason) {
+    if (queue.pending.empty()) return;
+
+    // 모든 슬롯이 한 worker에 몰려도 ring 용량(= 슬롯 수)을 넘지 않음
+    queue.packets.pushBatch(queue.pending.data(), queue.pending.size());
+
+    m_handoff_stats.batches++;
+    m_handoff_stats.packets += queue.pending.size();
+    if (reason == PUBLISH_FULL) {
+        m_handoff_stats.full_batches++;
+    } else if (reason == PUBLISH_TIMEOUT) {
+        m_handoff_stats.timeout_batches++;
+    } else {
+        m_handoff_stats.flush_batches++;
+    }
+    queue.pending.clear();
+
+    ringDoorbell(queue);
+}
+
+void PacketParser::publishExpired(std::chrono::steady_clock::time_point now) {
+    m_handoff_deadline = std::chrono::steady_clock::time_point::max();
+    for (auto& queue : m_worker_queues) {
+        if (queue->pending.empty()) continue;
+        if (now - queue->pending_since >= m_handoff_timeout) {
+            publishPending(*queue, PUBLISH_TIMEOUT);
+        } else {
+            m_handoff_deadline = std::min(m_handoff_deadline, queue->pending_since + m_handoff_timeout);
+        }
+    }
 }
 
-void PacketParser::parsePacket(const struct pcap_pkthdr* header, const u_char* packet, int worker_id) {
-    if (!packet || static_cast<size_t>(header->caplen) < sizeof(EthernetHeader)) return;
+void PacketParser::flushHandoff() {
+    if (m_inline) {
+        // 캡처 스레드가 곧 decode 스레드이므로 모아 둔 레코드 배치도 여기서 넘김
+        m_pipeline.flush(0);
+        return;
+    }
+    for (auto& queue : m_worker_queues) {
+        publishPending(*queue, PUBLISH_FLUSH);
+    }
+    m_handoff_deadline = std::chrono::steady_clock::time_point::max();
+}
 
-    const EthernetHeader* eth_header = (const EthernetHeader*)(packet);
-    uint16_t eth_type = ntohs(eth_header->eth_type);
-    const u_char* l3_payload = packet + sizeof(EthernetHeader);
-    int l3_payload_size = header->caplen - sizeof(EthernetHeader);
+void PacketParser::parseChunk(std::shared_ptr<OfflineChunk> chunk) {
+    if (m_inline) {
+        m_packets_queued += chunk->size();
+        for (const OfflinePacket& packet : *chunk) {
+            parsePacket(&packet.header, packet.data, packet.linktype, 0);
+            m_pipeline.endPacket(0);
+        }
+        m_packets_processed += chunk->size();
+        return;
+    }
 
-    std::string src_mac_str = mac_to_string_helper(eth_header->src_mac);
-    std::string dst_mac_str = mac_to_string_helper(eth_header->dest_mac);
+    if (m_num_threads == 1) {
+        pushChunk(0, std::move(chunk));
+        return;
+    }
+
+    // flow별로 worker chunk를 나눔 (chunk 안의 순서는 유지)
+    std::vector<std::shared_ptr<OfflineChunk>> parts(m_num_threads);
+    for (const OfflinePacket& packet : *chunk) {
+        auto& part = parts[selectWorker(computeFlowHash(packet.linktype, packet.data, packet.header.caplen))];
+        if (!part) {
+            part = std::make_shared<OfflineChunk>();
+            part->reserve(chunk->size() / m_num_threads * 2);
+        }
+        part->push_back(packet);
+    }
+
+    for (int i = 0; i < m_num_threads; ++i) {
+        if (parts[i]) {
+            pushChunk(i, std::move(parts[i]));
+        }
+    }
+}
+
+void PacketParser::pushChunk(int worker_id, std::shared_ptr<OfflineChunk> chunk) {
+    WorkerQueue& queue = *m_worker_queues[worker_id];
+    size_t packets = chunk->size();
+
+    m_packets_queued += packets;
+    {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        bool pushed = false;
+        m_chunk_space_cv.wait(lock, [this, &queue, &chunk, &pushed] {
+            return m_stop_flag.load() || (pushed = queue.chunks.push(chunk));
+        });
+        if (!pushed) return;
+    }
+
+    ringDoorbell(queue);
+}
+
+int PacketParser::selectWorker(uint32_t flow_hash) const {
+    return static_cast<int>(flow_hash % static_cast<uint32_t>(m_num_threads));
+}
+
+void PacketParser::ringDoorbell(WorkerQueue& queue) {
+    // worker의 sleeping 설정과 짝을 이루는 fence: 둘 중 하나는 반드시 상대의 기록을 봄
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue.sleeping.load()) {
+        std::lock_guard<std::mutex> lock(queue.doorbell_mutex);
+        queue.doorbell.notify_one();
+        m_handoff_stats.doorbells++;
+    }
+}
+
+bool PacketParser::workerQueuesEmpty() const {
+    for (const auto& queue : m_worker_queues) {
+        if (!queue->packets.empty() || !queue->chunks.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PacketParser::setReassemblyConfig(const ReassemblyConfig& config) {
+    ReassemblyConfig per_worker = config;
+    per_worker.max_bytes = config.max_bytes / static_cast<size_t>(m_num_threads);
+    for (auto& reassembler : m_reassemblers) {
+        reassembler->configure(per_worker);
+    }
+}
+
+ReassemblyStats PacketParser::getReassemblyStats() const {
+    ReassemblyStats stats;
+    for (const auto& reassembler : m_reassemblers) {
+        reassembler->addStatsTo(stats);
+    }
+    return stats;
+}
+
+void PacketParser::setTcpStreamConfig(const TcpStreamConfig& config) {
+    TcpStreamConfig per_worker = config;
+    per_worker.max_bytes = config.max_bytes / static_cast<size_t>(m_num_threads);
+    for (auto& streams : m_tcp_streams) {
+        streams->configure(per_worker);
+    }
+}
+
+TcpStreamStats PacketParser::getTcpStreamStats() const {
+    TcpStreamStats stats;
+    for (const auto& streams : m_tcp_streams) {
+        streams->addStatsTo(stats);
+    }
+    return stats;
+}
+
+void PacketParser::parsePacket(const struct pcap_pkthdr* header, const u_char* packet, int datalink, int worker_id) {
+    if (!packet) return;
+
+    // L2-L4를 고정 길이 필드로만 디코딩 (MAC/IP/timestamp 문자열은 레코드를 만들 때 변환)
+    PacketInfo info;
+    DecodeResult result = packet_decoder::decode(datalink, header, packet, m_nano_timestamps, info);
+    if (result == DECODE_UNSUPPORTED_LINK) {
+        if (!isSupportedDatalink(datalink) && !m_datalink_warned.exchange(true)) {
+            std::cerr << "[WARN] Unsupported link type " << datalink << ", packets will be skipped" << std::endl;
+        }
+        return;
+    }
+
+    // 조각만 재조립 테이블을 거치고, 완성된 datagram은 재조립 버퍼에서 다시 decode
+    // (조각이 아닌 패킷은 패킷 버퍼를 그대로 가리킨 채 파싱)
+    if (result == DECODE_FRAGMENT) {
+        struct pcap_pkthdr whole;
+        const u_char* datagram = m_reassemblers[worker_id]->add(header, packet, info.l3_offset, whole);
+        if (!datagram) return;
+        info = PacketInfo();
+        result = packet_decoder::decode(datalink, &whole, datagram, m_nano_timestamps, info);
+    }
+    if (result != DECODE_OK) return;
 
     auto& parsers = m_worker_parsers[worker_id];
 
     // ARP 패킷 처리
-    if (eth_type == 0x0806) {
-        PacketInfo info;
-        info.timestamp = format_timestamp(header->ts);
-        info.src_mac = src_mac_str;
-        info.dst_mac = dst_mac_str;
-        info.eth_type = eth_type;
-        info.payload = l3_payload;
-        info.payload_size = l3_payload_size;
-
+    if (info.eth_type == 0x0806) {
         for (const auto& parser : parsers) {
             if (parser->getName() == "arp") {
                 parser->parse(info);
@@ -502,124 +855,63 @@ void PacketParser::parsePacket(const struct pcap_pkthdr* header, const u_char* p
         return;
     }
 
-    // IPv4 패킷 처리
-    if (eth_type == 0x0800) {
-        // size_t로 캐스팅하여 경고 제거
-        if (static_cast<size_t>(l3_payload_size) < sizeof(IPHeader)) return;
-        
-        const IPHeader* ip_header = (const IPHeader*)(l3_payload);
-        char src_ip_str[INET_ADDRSTRLEN];
-        char dst_ip_str[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &(ip_header->ip_src), src_ip_str, INET_ADDRSTRLEN);
-        inet_ntop(AF_INET, &(ip_header->ip_dst), dst_ip_str, INET_ADDRSTRLEN);
-
-        // Use IP Total Length to calculate actual payload size (not captured buffer size)
-        // This prevents garbage data in ACK packets from being counted as payload
-        uint16_t ip_total_len = ntohs(ip_header->len);
-        int ip_header_len = ip_header->hl * 4;
-
-        const u_char* l4_payload = l3_payload + ip_header_len;
-        int l4_payload_size = ip_total_len - ip_header_len;
-
-        // TCP 패킷 처리
-        if (ip_header->p == IPPROTO_TCP) {
-            // size_t로 캐스팅하여 경고 제거
-            if (static_cast<size_t>(l4_payload_size) < sizeof(TCPHeader)) return;
-            
-            const TCPHeader* tcp_header = (const TCPHeader*)(l4_payload);
-            
-            int tcp_header_len = tcp_header->off * 4;
-            const u_char* l7_payload = l4_payload + tcp_header_len;
-            int l7_payload_size = l4_payload_size - tcp_header_len;
-
-            PacketInfo info;
-            info.timestamp = format_timestamp(header->ts);
-            info.src_mac = src_mac_str;
-            info.dst_mac = dst_mac_str;
-            info.eth_type = eth_type;
-            info.src_ip = src_ip_str;
-            info.dst_ip = dst_ip_str;
-            info.src_port = ntohs(tcp_header->sport);
-            info.dst_port = ntohs(tcp_header->dport);
-            info.protocol = IPPROTO_TCP;
-            info.tcp_seq = ntohl(tcp_header->seq);
-            info.tcp_ack = ntohl(tcp_header->ack);
-            info.tcp_flags = tcp_header->flags;
-            info.payload = l7_payload;
-            info.payload_size = l7_payload_size;
-            info.flow_id = get_canonical_flow_id(info.src_ip, info.src_port, info.dst_ip, info.dst_port);
-
-            bool handled_by_specific_app_parser = false;
-            for (const auto& parser : parsers) {
-                const auto& name = parser->getName();
-                if (name == "tcp_session" || name == "unknown" || name == "arp") {
-                    continue;
-                }
-
-                if (parser->isProtocol(info)) {
-                    parser->parse(info);
-                    handled_by_specific_app_parser = true;
-                    break;
-                }
+    // IPv4/IPv6 모두 같은 TCP/UDP 파서 경로로 보냄 (IPv6 두 번째 이후 조각은 protocol이 44로 남아 제외됨)
+    if (info.eth_type != 0x0800 && info.eth_type != 0x86DD) return;
+    if (info.protocol != IPPROTO_TCP && info.protocol != IPPROTO_UDP) return;
+
+    // 길이 prefix 프로토콜(MBAP/TPKT/XGT)의 TCP segment는 stream으로 이어 붙여 PDU 하나씩 파서에 넘김
+    // (-1 = payload가 없거나 framing이 맞지 않는 segment, 기존처럼 segment 그대로 파싱)
+    // PDU가 나오지 않은 segment(PDU 일부, 순서 대기, 재전송)도 tcp_session 레코드로 남김
+    if (info.protocol == IPPROTO_TCP && m_tcp_streams[worker_id]->enabled()) {
+        TcpFraming framing = tcpFramingForPorts(info.src_port, info.dst_port);
+        if (framing != FRAMING_NONE) {
+            PacketInfo adu = info;
+            int pdus = m_tcp_streams[worker_id]->add(info, framing, [&](const u_char* pdu, int size) {
+                adu.payload = pdu;
+                adu.payload_size = size;
+                dispatchTransport(adu, worker_id);
+            });
+            if (pdus > 0) return;
+            if (pdus == 0) {
+                dispatchFallback(info, worker_id);
+                return;
             }
+        }
+    }
 
-            if (!handled_by_specific_app_parser) {
-                for (const auto& parser : parsers) {
-                    if (parser->getName() == "tcp_session") {
-                        parser->parse(info);
-                        break;
-                    }
-                }
-            }
+    dispatchTransport(info, worker_id);
+}
+
+// TCP/UDP 패킷(또는 재조립된 PDU)을 첫 번째로 맞는 애플리케이션 파서에 넘김
+void PacketParser::dispatchTransport(const PacketInfo& info, int worker_id) {
+    auto& parsers = m_worker_parsers[worker_id];
+
+    bool handled_by_specific_app_parser = false;
+    for (const auto& parser : parsers) {
+        const auto& name = parser->getName();
+        if (name == "tcp_session" || name == "unknown" || name == "arp") {
+            continue;
         }
-        // UDP 패킷 처리
-        else if (ip_header->p == IPPROTO_UDP) {
-            // size_t로 캐스팅하여 경고 제거
-            if (static_cast<size_t>(l4_payload_size) < sizeof(UDPHeader)) return;
-            
-            const UDPHeader* udp_header = (const UDPHeader*)(l4_payload);
-            const u_char* l7_payload = l4_payload + sizeof(UDPHeader);
-            int l7_payload_size = l4_payload_size - sizeof(UDPHeader);
-
-            PacketInfo info;
-            info.timestamp = format_timestamp(header->ts);
-            info.src_mac = src_mac_str;
-            info.dst_mac = dst_mac_str;
-            info.eth_type = eth_type;
-            info.src_ip = src_ip_str;
-            info.dst_ip = dst_ip_str;
-            info.src_port = ntohs(udp_header->sport);
-            info.dst_port = ntohs(udp_header->dport);
-            info.protocol = IPPROTO_UDP;
-            info.tcp_seq = 0;
-            info.tcp_ack = 0;
-            info.tcp_flags = 0;
-            info.payload = l7_payload;
-            info.payload_size = l7_payload_size;
-            info.flow_id = get_canonical_flow_id(info.src_ip, info.src_port, info.dst_ip, info.dst_port);
-
-            bool specific_app_protocol_found = false;
-            for (const auto& parser : parsers) {
-                const auto& name = parser->getName();
-                if (name == "tcp_session" || name == "unknown" || name == "arp") {
-                    continue;
-                }
-
-                if (parser->isProtocol(info)) {
-                    parser->parse(info);
-                    specific_app_protocol_found = true;
-                    break;
-                }
-            }
 
-            if (!specific_app_protocol_found) {
-                for (const auto& parser : parsers) {
-                    if (parser->getName() == "unknown") {
-                        parser->parse(info);
-                        break;
-                    }
-                }
-            }
+        if (parser->isProtocol(info)) {
+            parser->parse(info);
+            handled_by_specific_app_parser = true;
+            break;
         }
     }
-}
\ No newline at end of file
+
+    // 특정 프로토콜이 아니면 TCP는 tcp_session, UDP는 unknown 레코드
+    if (!handled_by_specific_app_parser) {
+        dispatchFallback(info, worker_id);
+    }
+}
+
+void PacketParser::dispatchFallback(const PacketInfo& info, int worker_id) {
+    const char* fallback = (info.protocol == IPPROTO_TCP) ? "tcp_session" : "unknown";
+    for (const auto& parser : m_worker_parsers[worker_id]) {
+        if (parser->getName() == fallback) {
+            parser->parse(info);
+            break;
+        }
+    }
+}
@@ -9,24 +9,67 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <atomic>
+#include <chrono>
 #ifndef _WIN32
 #include <sys/time.h>
 #endif
 #include "./protocols/IProtocolParser.h"
+#include "./capture/ICaptureBackend.h"
+#include "./capture/OfflinePcapReader.h"
+#include "./capture/PacketPool.h"
+#include "./capture/SpscRing.h"
+#include "./network/flow_hash.h"
+#include "./network/Ipv4Reassembler.h"
+#include "./network/TcpStreamReassembler.h"
+#include "./pipeline/RecordPipeline.h"
 #include "AssetManager.h"
 #include "UnifiedWriter.h"
 #include "RedisCache.h"
 #include "ElasticsearchClient.h"
 
-// 패킷 데이터를 저장하는 구조체
-struct PacketData {
-    struct pcap_pkthdr header;
-    std::vector<u_char> packet;
-    
-    PacketData(const struct pcap_pkthdr* h, const u_char* p) 
-        : header(*h), packet(p, p + h->caplen) {}
+// 캡처 스레드 -> worker 배치 전달 통계
+struct HandoffStats {
+    uint64_t batches = 0;
+    uint64_t packets = 0;
+    uint64_t full_batches = 0;      // 배치 크기에 도달해서 publish
+    uint64_t timeout_batches = 0;   // 배치 timeout으로 publish
+    uint64_t flush_batches = 0;     // 캡처가 idle이거나 종료할 때 publish
+    uint64_t doorbells = 0;         // 잠든 worker를 깨운 횟수
+};
+
+// 큐(풀 슬롯 수 또는 바이트 한도)가 가득 찼을 때의 동작
+enum OverloadPolicy {
+    OVERLOAD_BLOCK,              // 캡처를 멈추고 슬롯이 빌 때까지 대기 (오프라인 기본값)
+    OVERLOAD_DROP_NEWEST,        // 새 패킷을 드롭 (라이브 기본값)
+    OVERLOAD_DROP_OLDEST,        // 가장 밀린 worker 큐의 오래된 패킷을 버리고 새 패킷을 넣음
+    OVERLOAD_SHED_LOW_PRIORITY   // 큐가 3/4 이상 차면 ICS/ARP 외 트래픽부터 드롭, 가득 차면 새 패킷 드롭
+};
+
+bool parseOverloadPolicy(const std::string& name, OverloadPolicy& policy);
+const char* overloadPolicyName(OverloadPolicy policy);
+
+enum DropReason {
+    DROP_QUEUE_FULL = 0,   // 새 패킷을 넣을 자리가 없음
+    DROP_EVICTED,          // drop_oldest로 밀려난 패킷
+    DROP_SHED,             // shed_low_priority로 미리 버린 패킷
+    DROP_REASON_COUNT
+};
+
+const char* dropReasonName(int reason);
+
+// 과부하로 잃은 패킷 (사유 x 트래픽 분류)
+struct OverloadStats {
+    uint64_t drops[DROP_REASON_COUNT][TRAFFIC_CLASS_COUNT] = {};
+    uint64_t blocked = 0;   // block 정책에서 캡처가 대기한 횟수
+
+    uint64_t totalDrops() const {
+        uint64_t total = 0;
+        for (const auto& reason : drops) {
+            for (uint64_t count : reason) total += count;
+        }
+        return total;
+    }
 };
 
 class PacketParser {
@@ -39,9 +82,61 @@ public:
                  bool disable_file_output = false);
     ~PacketParser();
     
-    void parse(const struct pcap_pkthdr* header, const u_char* packet);
+    // 패킷을 풀 슬롯에 담아 큐에 넣음 (lease가 있으면 복사 없이 백엔드 버퍼를 가리킴)
+    // 큐가 가득 차면 setOverloadPolicy()의 정책에 따라 대기하거나 드롭
+    void parse(const struct pcap_pkthdr* header, const u_char* packet, PacketLease* lease = nullptr);
+    // 오프라인 reader가 만든 chunk를 flow별로 나눠 worker에게 넘김 (큐가 가득 차면 대기)
+    void parseChunk(std::shared_ptr<OfflineChunk> chunk);
     void generateUnifiedOutput();
     
+    // PACKET_FANOUT 모드: worker마다 캡처 백엔드를 하나씩 소유 (공유 큐 미사용)
+    // startWorkers() 전에 호출해야 하며, backends.size()는 getNumThreads()와 같아야 합니다.
+    void attachWorkerBackends(std::vector<std::unique_ptr<ICaptureBackend>> backends, int poll_timeout_ms);
+    bool getCaptureStats(CaptureStats& stats);
+    int getNumThreads() const { return m_num_threads; }
+
+    // 등록된 파서들의 getCaptureFilter()를 OR로 묶은 BPF 식
+    // allow_list가 비어 있지 않으면 해당 이름의 파서만, tcp_session은 keep_tcp_session일 때만 포함
+    // include_vlan이면 802.1Q/QinQ로 태그된 같은 트래픽도 통과 (Ethernet 링크에서만 컴파일 가능)
+    std::string buildCaptureFilter(const std::vector<std::string>& allow_list, bool keep_tcp_session,
+                                   bool include_vlan = false) const;
+
+    // parse() 경로에서 쓰는 패킷 슬롯 풀, startWorkers() 전에 설정
+    bool initPacketPool(const PacketPoolConfig& config, int snaplen);
+    // 큐 한도는 패킷 수(풀 슬롯 수)와 max_bytes(0 = 제한 없음) 중 먼저 닿는 쪽
+    void setOverloadPolicy(OverloadPolicy policy, size_t max_bytes);
+    const OverloadStats& getOverloadStats() const { return m_overload_stats; }
+
+    // worker로 넘기는 배치 크기/최대 대기 시간 (batch_size 1 = 패킷마다 publish)
+    void setHandoffBatch(size_t batch_size, int timeout_us);
+    // 모아 둔 배치를 바로 publish (parse()를 호출하는 캡처 스레드에서 호출)
+    void flushHandoff();
+    const HandoffStats& getHandoffStats() const { return m_handoff_stats; }
+
+    // 캡처 핸들의 링크 타입 (pcap_datalink()), startWorkers() 전에 설정
+    // 오프라인 chunk는 패킷마다 자체 링크 타입을 사용
+    void setDatalink(int datalink) { m_datalink = datalink; }
+
+    // 캡처 핸들의 timestamp 정밀도 (PCAP_TSTAMP_PRECISION_*), startWorkers() 전에 설정
+    void setTimestampPrecision(int precision) { m_nano_timestamps = (precision == PCAP_TSTAMP_PRECISION_NANO); }
+
+    // run-to-completion: 캡처 스레드가 parse()/parseChunk() 안에서 바로 파싱 (복사/큐/worker 없음)
+    // worker 스레드가 1개인 파서에서 startWorkers() 전에 설정
+    void setInlineMode(bool enabled) { m_inline = enabled && m_num_threads == 1; }
+    bool isInlineMode() const { return m_inline; }
+
+    // IPv4 조각 재조립 테이블 (worker마다 하나, max_bytes는 worker 수로 나눠 적용), startWorkers() 전에 설정
+    void setReassemblyConfig(const ReassemblyConfig& config);
+    ReassemblyStats getReassemblyStats() const;
+
+    // Modbus/S7/XGT TCP stream 재조립 (worker마다 하나, max_bytes는 worker 수로 나눠 적용, 0 = 끔)
+    void setTcpStreamConfig(const TcpStreamConfig& config);
+    TcpStreamStats getTcpStreamStats() const;
+
+    // decode(worker) 뒤의 enrich/serialize/sink 단계 설정, startWorkers() 전에 호출
+    void setPipelineConfig(const PipelineConfig& config) { m_pipeline.configure(config, m_num_threads); }
+    const RecordPipeline& getPipeline() const { return m_pipeline; }
+
     // 멀티스레딩 제어
     void startWorkers();
     void stopWorkers();
@@ -70,24 +165,92 @@ private:
 
     // 워커별 파서
     std::vector<std::vector<std::unique_ptr<IProtocolParser>>> m_worker_parsers;
+
+    // 워커별 IPv4 조각 재조립 (worker 배정이 주소 쌍+프로토콜 기준이라 조각과 같은 flow의 나머지 패킷이 한 worker에 모임)
+    std::vector<std::unique_ptr<Ipv4Reassembler>> m_reassemblers;
+    // 워커별 TCP stream 재조립 (flow hash가 양방향을 같은 worker로 보냄)
+    std::vector<std::unique_ptr<TcpStreamReassembler>> m_tcp_streams;
+
+    // 파서가 만든 레코드를 enrich -> serialize -> sink로 넘김 (worker id = producer)
+    RecordPipeline m_pipeline;
     
     // 멀티스레딩 관련
     std::vector<std::thread> m_workers;
-    std::queue<std::shared_ptr<PacketData>> m_packet_queue;
-    std::mutex m_queue_mutex;
-    std::condition_variable m_queue_cv;
+    std::thread m_flush_thread;              // ES 실시간 flush (파이프라인 sink가 비워진 뒤에 종료)
+    std::atomic<bool> m_flush_stop{false};
+    std::mutex m_queue_mutex;    // chunk 공간 / 풀 슬롯 대기용
     std::atomic<bool> m_stop_flag;
     std::atomic<size_t> m_packets_processed;
     std::atomic<size_t> m_packets_queued;
 
+    // worker별 입력 큐: 캡처 스레드가 flow hash로 worker를 정해 SPSC ring에 넣음
+    // 같은 flow(양방향)는 항상 같은 worker가 처리하므로 파서의 flow 상태에 lock이 필요 없음
+    struct WorkerQueue {
+        SpscRing<PacketSlot*> packets;                    // 용량 = 풀 슬롯 수이므로 넘치지 않음
+        SpscRing<std::shared_ptr<OfflineChunk>> chunks;   // reader가 너무 앞서 가지 않도록 작게 유지
+        std::mutex doorbell_mutex;
+        std::condition_variable doorbell;
+        std::atomic<bool> sleeping{false};
+
+        // 캡처 스레드 전용: 아직 publish하지 않은 슬롯
+        std::vector<PacketSlot*> pending;
+        std::chrono::steady_clock::time_point pending_since;
+    };
+    std::vector<std::unique_ptr<WorkerQueue>> m_worker_queues;
+    std::condition_variable m_chunk_space_cv;
+
+    // 배치 전달 (캡처 스레드에서만 접근)
+    size_t m_handoff_batch = 32;
+    std::chrono::microseconds m_handoff_timeout{200};
+    std::chrono::steady_clock::time_point m_handoff_deadline = std::chrono::steady_clock::time_point::max();
+    HandoffStats m_handoff_stats;
+
+    // 패킷 슬롯 풀 (빈 슬롯을 기다리는 캡처 스레드는 m_slot_cv에서 대기)
+    PacketPool m_pool;
+    std::atomic<bool> m_pool_waiting{false};
+    std::condition_variable m_slot_cv;
+
+    // 큐 한도와 과부하 정책 (m_overload_stats는 캡처 스레드에서만 갱신)
+    OverloadPolicy m_overload_policy = OVERLOAD_DROP_NEWEST;
+    size_t m_queue_max_bytes = 0;
+    std::atomic<size_t> m_queued_bytes{0};
+    OverloadStats m_overload_stats;
+
+    // worker별 캡처 백엔드 (PACKET_FANOUT 모드에서만 사용)
+    std::vector<std::unique_ptr<ICaptureBackend>> m_worker_backends;
+    int m_capture_poll_timeout_ms = 1000;
+    bool m_nano_timestamps = false;
+    bool m_inline = false;
+    int m_datalink = DLT_EN10MB;
+    std::atomic<bool> m_datalink_warned{false};
+
+    struct WorkerCaptureContext {
+        PacketParser* parser;
+        int worker_id;
+    };
+
     void workerThread(int worker_id);
-    void parsePacket(const struct pcap_pkthdr* header, const u_char* packet, int worker_id);
+    void captureWorkerLoop(int worker_id);
+    static void workerPacketCallback(u_char* user, const struct pcap_pkthdr* header,
+                                     const u_char* packet, PacketLease* lease);
+    void parsePacket(const struct pcap_pkthdr* header, const u_char* packet, int datalink, int worker_id);
+    void dispatchTransport(const PacketInfo& info, int worker_id);
+    // 애플리케이션 파서가 없는 TCP(tcp_session)/UDP(unknown) 레코드
+    void dispatchFallback(const PacketInfo& info, int worker_id);
+    void releaseSlot(PacketSlot* slot);
+    PacketSlot* admitPacket(const FlowHint& hint, uint32_t caplen);
+    PacketSlot* evictOldest(uint32_t caplen);
+    bool hasByteRoom(uint32_t caplen) const;
+    bool aboveShedMark(uint32_t caplen) const;
+    int selectWorker(uint32_t flow_hash) const;
+    void ringDoorbell(WorkerQueue& queue);
+    enum PublishReason { PUBLISH_FULL, PUBLISH_TIMEOUT, PUBLISH_FLUSH };
+    void publishPending(WorkerQueue& queue, PublishReason reason);
+    void publishExpired(std::chrono::steady_clock::time_point now);
+    void pushChunk(int worker_id, std::shared_ptr<OfflineChunk> chunk);
+    bool workerQueuesEmpty() const;
     void createParsersForWorker(int worker_id);
     void realtimeFlushThread();
-    
-    std::string get_canonical_flow_id(const std::string& ip1, uint16_t port1, const std::string& ip2, uint16_t port2);
-    
-    void sendToBackends(const UnifiedRecord& record);
 };
 
 
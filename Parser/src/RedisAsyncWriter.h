@@ -10,6 +10,7 @@
 #include <hiredis/hiredis.h>
 #include <nlohmann/json.hpp>
 #include "RedisConnectionPool.h"
+#include "ThreadPlacement.h"
 
 using json = nlohmann::json;
 
@@ -159,6 +160,7 @@ private:
     std::atomic<size_t> m_total_dropped;
     
     void writerWorker(int worker_id) {
+        ThreadPlacement::apply(ThreadRole::REDIS, worker_id);
         std::cout << "[AsyncWriter-" << worker_id << "] Started" << std::endl;
         
         std::vector<WriteTask> batch;
@@ -71,6 +71,7 @@ struct ParsedPacketData {
     std::string ak;    // TCP acknowledgement
     std::string fl;    // TCP flags
     std::string dir;   // direction
+    std::string vlan;  // 태그 없으면 빈 값
 
     // 자산 정보
     std::string src_asset_id;
@@ -100,6 +101,10 @@ struct ParsedPacketData {
             {"dir", dir}
         };
 
+        if (!vlan.empty()) {
+            j["vlan"] = vlan;
+        }
+
         // 자산 정보 추가 (문자열로만, IP 정보 제외)
         if (!src_asset_name.empty()) {
             j["src_asset"] = src_asset_name;
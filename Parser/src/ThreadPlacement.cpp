@@ -0,0 +1,249 @@
+#include "ThreadPlacement.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sched.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#endif
+
+std::vector<int> ThreadPlacement::s_cpus[static_cast<int>(ThreadRole::COUNT)];
+
+namespace {
+
+#ifndef _WIN32
+// 첫 설정 시점의 프로세스 affinity (고정하지 않는 역할은 여기로 되돌림)
+cpu_set_t g_default_mask;
+bool g_default_mask_saved = false;
+
+void saveDefaultMask() {
+    if (g_default_mask_saved) return;
+    CPU_ZERO(&g_default_mask);
+    if (sched_getaffinity(0, sizeof(g_default_mask), &g_default_mask) == 0) {
+        g_default_mask_saved = true;
+    }
+}
+#endif
+
+const char* ROLE_NAMES[] = {"capture", "workers", "flush", "es", "redis", "pipeline"};
+
+bool parseCpuList(const std::string& list, std::vector<int>& cpus) {
+    cpus.clear();
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+        size_t dash = item.find('-');
+        try {
+            int first = std::stoi(item.substr(0, dash));
+            int last = (dash == std::string::npos) ? first : std::stoi(item.substr(dash + 1));
+            if (first < 0 || last < first) return false;
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return true;
+}
+
+std::string formatCpuList(const std::vector<int>& cpus) {
+    std::string out;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        if (!out.empty()) out += ",";
+        out += std::to_string(cpus[i]);
+        if (j > i) out += "-" + std::to_string(cpus[j]);
+        i = j + 1;
+    }
+    return out;
+}
+
+// /sys/devices/system/cpu/cpuN/nodeM 링크로 NUMA 노드를 찾음
+int cpuNode(int cpu) {
+#ifndef _WIN32
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return -1;
+
+    int node = -1;
+    while (struct dirent* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = std::atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+} // namespace
+
+const char* ThreadPlacement::roleName(ThreadRole role) {
+    return ROLE_NAMES[static_cast<int>(role)];
+}
+
+bool ThreadPlacement::setRoleCpus(ThreadRole role, const std::string& cpu_list) {
+    std::vector<int> cpus;
+    if (!parseCpuList(cpu_list, cpus)) {
+        std::cerr << "[ERROR] Invalid CPU list for " << roleName(role) << ": " << cpu_list << std::endl;
+        return false;
+    }
+
+#ifndef _WIN32
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    for (int cpu : cpus) {
+        if (configured > 0 && cpu >= configured) {
+            std::cerr << "[ERROR] CPU " << cpu << " for " << roleName(role)
+                      << " does not exist (" << configured << " CPUs)" << std::endl;
+            return false;
+        }
+    }
+    saveDefaultMask();
+#endif
+
+    s_cpus[static_cast<int>(role)] = cpus;
+    return true;
+}
+
+bool ThreadPlacement::parseAssignment(const std::string& spec) {
+    size_t eq = spec.find('=');
+    if (eq == std::string::npos) {
+        std::cerr << "[ERROR] CPU assignment must look like role=cpus: " << spec << std::endl;
+        return false;
+    }
+
+    std::string name = spec.substr(0, eq);
+    if (name == "worker") name = "workers";
+    if (name == "elasticsearch") name = "es";
+
+    for (int i = 0; i < static_cast<int>(ThreadRole::COUNT); ++i) {
+        if (name == ROLE_NAMES[i]) {
+            return setRoleCpus(static_cast<ThreadRole>(i), spec.substr(eq + 1));
+        }
+    }
+    std::cerr << "[ERROR] Unknown thread role: " << name
+              << " (expected capture, workers, flush, es, redis or pipeline)" << std::endl;
+    return false;
+}
+
+bool ThreadPlacement::parseAssignments(const std::string& specs) {
+    std::stringstream ss(specs);
+    std::string spec;
+    while (std::getline(ss, spec, ';')) {
+        if (!spec.empty() && !parseAssignment(spec)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ThreadPlacement::isConfigured() {
+    for (const auto& cpus : s_cpus) {
+        if (!cpus.empty()) return true;
+    }
+    return false;
+}
+
+void ThreadPlacement::apply(ThreadRole role, int index) {
+#ifndef _WIN32
+    if (!isConfigured()) return;
+
+    const std::vector<int>& cpus = s_cpus[static_cast<int>(role)];
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+
+    if (cpus.empty()) {
+        if (!g_default_mask_saved) return;
+        mask = g_default_mask;
+    } else if (role == ThreadRole::WORKER) {
+        CPU_SET(cpus[static_cast<size_t>(index) % cpus.size()], &mask);
+    } else {
+        for (int cpu : cpus) CPU_SET(cpu, &mask);
+    }
+
+    if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+        std::cerr << "[WARN] Could not pin " << roleName(role) << " thread " << index
+                  << ": " << strerror(errno) << std::endl;
+    }
+#else
+    (void)role;
+    (void)index;
+#endif
+}
+
+int ThreadPlacement::nodeForRole(ThreadRole role, int index) {
+    const std::vector<int>& cpus = s_cpus[static_cast<int>(role)];
+    if (cpus.empty()) return -1;
+    int cpu = (role == ThreadRole::WORKER) ? cpus[static_cast<size_t>(index) % cpus.size()] : cpus[0];
+    return cpuNode(cpu);
+}
+
+bool ThreadPlacement::bindMemory(void* addr, size_t len, int node) {
+#if !defined(_WIN32) && defined(SYS_mbind)
+    if (node < 0 || node >= static_cast<int>(sizeof(unsigned long) * 8)) return false;
+
+    const int MPOL_PREFERRED_MODE = 1;
+    unsigned long nodemask = 1UL << node;
+    if (syscall(SYS_mbind, addr, len, MPOL_PREFERRED_MODE, &nodemask, sizeof(nodemask) * 8, 0) != 0) {
+        std::cerr << "[WARN] Could not bind memory to NUMA node " << node << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+#else
+    (void)addr;
+    (void)len;
+    (void)node;
+    return false;
+#endif
+}
+
+void ThreadPlacement::printTopology(int worker_count, int redis_writers) {
+#ifndef _WIN32
+    std::cout << "[Config] CPU topology: " << sysconf(_SC_NPROCESSORS_ONLN) << " CPUs online" << std::endl;
+    for (int node = 0;; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in.is_open()) break;
+        std::string cpulist;
+        std::getline(in, cpulist);
+        std::cout << "  NUMA node " << node << ": CPUs " << cpulist << std::endl;
+    }
+#endif
+
+    if (!isConfigured()) {
+        std::cout << "  Thread placement: not configured (scheduler decides)" << std::endl;
+        return;
+    }
+
+    auto describe = [](ThreadRole role, int index) {
+        const std::vector<int>& cpus = s_cpus[static_cast<int>(role)];
+        if (cpus.empty()) return std::string("unpinned");
+        std::vector<int> used = cpus;
+        if (role == ThreadRole::WORKER) used = {cpus[static_cast<size_t>(index) % cpus.size()]};
+        int node = nodeForRole(role, index);
+        return "CPU " + formatCpuList(used) + (node >= 0 ? " (node " + std::to_string(node) + ")" : "");
+    };
+
+    std::cout << "  capture: " << describe(ThreadRole::CAPTURE, 0) << std::endl;
+    for (int i = 0; i < worker_count; ++i) {
+        std::cout << "  worker " << i << ": " << describe(ThreadRole::WORKER, i) << std::endl;
+    }
+    std::cout << "  flush: " << describe(ThreadRole::FLUSH, 0) << std::endl;
+    std::cout << "  es: " << describe(ThreadRole::ELASTICSEARCH, 0) << std::endl;
+    std::cout << "  pipeline: " << describe(ThreadRole::PIPELINE, 0) << std::endl;
+    if (redis_writers > 0) {
+        std::cout << "  redis (" << redis_writers << " writers): " << describe(ThreadRole::REDIS, 0) << std::endl;
+    }
+}
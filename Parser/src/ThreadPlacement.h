@@ -0,0 +1,49 @@
+#ifndef THREAD_PLACEMENT_H
+#define THREAD_PLACEMENT_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// 파서가 만드는 스레드의 역할
+enum class ThreadRole {
+    CAPTURE = 0,     // 메인 캡처 스레드
+    WORKER,          // PacketParser::workerThread (fanout 모드에서는 캡처도 담당)
+    FLUSH,           // PacketParser::realtimeFlushThread
+    ELASTICSEARCH,   // ElasticsearchClient::autoFlushLoop
+    REDIS,           // RedisAsyncWriter::writerWorker
+    PIPELINE,        // RecordPipeline 단계 스레드 (enrich/serialize/sink)
+    COUNT
+};
+
+// 역할별 CPU 고정과 NUMA 노드 배치
+// 설정은 startWorkers() 전에 메인 스레드에서 끝내고, 각 스레드는 시작할 때 apply()를 호출합니다.
+class ThreadPlacement {
+public:
+    // "workers=2-5" 형식 (역할: capture, workers, flush, es, redis, pipeline / CPU 목록: "0-3,8")
+    static bool parseAssignment(const std::string& spec);
+    // ';'로 구분한 여러 개 ("capture=0;workers=2-5;redis=1")
+    static bool parseAssignments(const std::string& specs);
+    static bool setRoleCpus(ThreadRole role, const std::string& cpu_list);
+
+    // 현재 스레드를 역할의 CPU에 고정
+    // worker는 목록을 index로 round-robin해서 CPU 하나씩, 나머지 역할은 목록 전체
+    // 역할에 설정이 없으면 다른 역할의 고정을 물려받지 않도록 원래 affinity로 되돌림
+    static void apply(ThreadRole role, int index = 0);
+
+    // 역할(worker는 index 번째)이 쓰는 CPU의 NUMA 노드, 설정이 없거나 알 수 없으면 -1
+    static int nodeForRole(ThreadRole role, int index = 0);
+
+    // 아직 touch하지 않은 메모리를 NUMA 노드에 우선 배치 (mbind MPOL_PREFERRED)
+    static bool bindMemory(void* addr, size_t len, int node);
+
+    static bool isConfigured();
+    static void printTopology(int worker_count, int redis_writers);
+
+    static const char* roleName(ThreadRole role);
+
+private:
+    static std::vector<int> s_cpus[static_cast<int>(ThreadRole::COUNT)];
+};
+
+#endif // THREAD_PLACEMENT_H
@@ -1,8 +1,9 @@
 #include "UnifiedWriter.h"
 #include <sstream>
-#include <iomanip>
 #include <algorithm>
 #include <iostream>
+#include <cstdio>
+#include "network/packet_format.h"
 
 #ifdef _WIN32
 #include <direct.h>
@@ -27,45 +28,25 @@ UnifiedWriter::~UnifiedWriter() {
     }
 }
 
-std::string UnifiedWriter::getTimeSlot(const std::string& timestamp) {
+std::string UnifiedWriter::getTimeSlot(int64_t ts_ns) {
     // time_interval이 0이면 "all" 슬롯 사용
     if (m_interval_minutes == 0) {
         return "output_all";
     }
     
-    // timestamp 형식: 2023-05-10T02:24:15.123456Z
-    if (timestamp.length() < 19) {
-        std::cout << "[WARN] Invalid timestamp format: " << timestamp << std::endl;
-        return "";
-    }
-    
-    struct tm tm_time = {};
-    std::string ts = timestamp.substr(0, 19);
-    
-    // 파싱
-    sscanf(ts.c_str(), "%d-%d-%dT%d:%d:%d",
-           &tm_time.tm_year, &tm_time.tm_mon, &tm_time.tm_mday,
-           &tm_time.tm_hour, &tm_time.tm_min, &tm_time.tm_sec);
-    
-    tm_time.tm_year -= 1900;
-    tm_time.tm_mon -= 1;
+    // 문자열을 다시 파싱하지 않고 원본 나노초에서 바로 계산
+    int64_t sec = ts_ns / 1000000000LL;
+    if (ts_ns % 1000000000LL < 0) sec--;
+    packet_format::UtcTime t = packet_format::utcTime(sec);
     
     // 분을 interval 단위로 내림
-    int slot_minute = (tm_time.tm_min / m_interval_minutes) * m_interval_minutes;
-    tm_time.tm_min = slot_minute;
-    tm_time.tm_sec = 0;
+    int slot_minute = (t.minute / m_interval_minutes) * m_interval_minutes;
     
     // 출력 형식: output_20230510_0224
-    std::stringstream ss;
-    ss << "output_"
-       << std::setfill('0') << std::setw(4) << (tm_time.tm_year + 1900)
-       << std::setfill('0') << std::setw(2) << (tm_time.tm_mon + 1)
-       << std::setfill('0') << std::setw(2) << tm_time.tm_mday
-       << "_"
-       << std::setfill('0') << std::setw(2) << tm_time.tm_hour
-       << std::setfill('0') << std::setw(2) << slot_minute;
-    
-    return ss.str();
+    char buf[sizeof "output_20230510_0224"];
+    std::snprintf(buf, sizeof buf, "output_%04d%02d%02d_%02d%02d",
+                  t.year, t.month, t.day, t.hour, slot_minute);
+    return std::string(buf);
 }
 
 std::string UnifiedWriter::escapeCSV(const std::string& s) {
@@ -86,7 +67,7 @@ std::string UnifiedWriter::escapeCSV(const std::string& s) {
 }
 
 void UnifiedWriter::addRecord(const UnifiedRecord& record) {
-    std::string time_slot = getTimeSlot(record.timestamp);
+    std::string time_slot = getTimeSlot(record.ts_ns);
     
     if (!time_slot.empty()) {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -99,6 +80,19 @@ void UnifiedWriter::addRecord(const UnifiedRecord& record) {
     }
 }
 
+void UnifiedWriter::addRecords(const std::vector<UnifiedRecord>& records) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& record : records) {
+        std::string time_slot = getTimeSlot(record.ts_ns);
+        if (time_slot.empty()) continue;
+
+        m_time_slots[time_slot].push_back(record);
+        if (m_backend_callback) {
+            m_backend_callback(record);
+        }
+    }
+}
+
 void UnifiedWriter::writeCsvHeader(std::ofstream& out) {
     out << "@timestamp,protocol,smac,dmac,sip,sp,dip,dp,sq,ak,fl,dir,"
         << "src_asset,dst_asset,"
@@ -108,7 +102,8 @@ void UnifiedWriter::writeCsvHeader(std::ofstream& out) {
         << "len,"
         << "modbus.tid,modbus.fc,modbus.err,modbus.bc,modbus.addr,modbus.qty,modbus.val,modbus.regs.addr,modbus.regs.val,modbus.translated_addr,modbus.description,"
         << "s7comm.prid,s7comm.ros,s7comm.fn,s7comm.ic,s7comm.syn,s7comm.tsz,s7comm.amt,s7comm.db,s7comm.ar,s7comm.addr,s7comm.rc,s7comm.len,s7comm.description,"
-        << "xgt_fen.prid,xgt_fen.companyId,xgt_fen.plcinfo,xgt_fen.cpuinfo,xgt_fen.source,xgt_fen.len,xgt_fen.fenetpos,xgt_fen.cmd,xgt_fen.dtype,xgt_fen.blkcnt,xgt_fen.errstat,xgt_fen.errinfo,xgt_fen.vars,xgt_fen.datasize,xgt_fen.data,xgt_fen.translated_addr,xgt_fen.description\n";
+        << "xgt_fen.prid,xgt_fen.companyId,xgt_fen.plcinfo,xgt_fen.cpuinfo,xgt_fen.source,xgt_fen.len,xgt_fen.fenetpos,xgt_fen.cmd,xgt_fen.dtype,xgt_fen.blkcnt,xgt_fen.errstat,xgt_fen.errinfo,xgt_fen.vars,xgt_fen.datasize,xgt_fen.data,xgt_fen.translated_addr,xgt_fen.description,"
+        << "vlan\n";
 }
 
 void UnifiedWriter::writeTimeSlot(const std::string& time_slot) {
@@ -121,7 +116,7 @@ void UnifiedWriter::writeTimeSlot(const std::string& time_slot) {
     // This is critical for Modbus responses where multiple register records share the same timestamp
     std::stable_sort(records.begin(), records.end(),
         [](const UnifiedRecord& a, const UnifiedRecord& b) {
-            return a.timestamp < b.timestamp;
+            return a.ts_ns < b.ts_ns;
         });
     
     // CSV 파일
@@ -215,7 +210,8 @@ void UnifiedWriter::writeTimeSlot(const std::string& time_slot) {
                 << escapeCSV(record.xgt_datasize) << ","
                 << escapeCSV(record.xgt_data) << ","
                 << escapeCSV(record.xgt_translated_addr) << ","
-                << escapeCSV(record.xgt_description) << "\n";
+                << escapeCSV(record.xgt_description) << ","
+                << escapeCSV(record.vlan) << "\n";
         
         // JSONL 작성 - CSV와 동일한 구조로 생성
         std::stringstream json_ss;
@@ -232,6 +228,7 @@ void UnifiedWriter::writeTimeSlot(const std::string& time_slot) {
         if (!record.ak.empty()) json_ss << R"("ak":)" << record.ak << R"(,)";
         if (!record.fl.empty()) json_ss << R"("fl":)" << record.fl << R"(,)";
         if (!record.dir.empty()) json_ss << R"("dir":")" << record.dir << R"(",)";
+        if (!record.vlan.empty()) json_ss << R"("vlan":")" << record.vlan << R"(",)";
 
         // 자산 정보
         if (!record.src_asset_name.empty()) {
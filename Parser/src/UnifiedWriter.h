@@ -1,6 +1,7 @@
 #ifndef UNIFIED_WRITER_H
 #define UNIFIED_WRITER_H
 
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -13,6 +14,7 @@
 struct UnifiedRecord {
     // 공통 필드
     std::string timestamp;
+    int64_t ts_ns = 0;   // timestamp의 원본 (epoch 나노초), 정렬과 시간 슬롯 계산은 이 값으로
     std::string protocol;
     std::string smac;
     std::string dmac;
@@ -24,6 +26,7 @@ struct UnifiedRecord {
     std::string ak;
     std::string fl;
     std::string dir;
+    std::string vlan;   // "10" 또는 QinQ "100.10" (태그 없으면 빈 값)
 
     // 자산 정보
     std::string src_asset_id;
@@ -113,6 +116,8 @@ public:
     
     // 레코드 추가 (스레드 안전)
     void addRecord(const UnifiedRecord& record);
+    // 배치를 lock 한 번으로 추가 (파이프라인 sink 단계)
+    void addRecords(const std::vector<UnifiedRecord>& records);
     
     // 파일 플러시 및 로테이션
     void flush();
@@ -133,8 +138,8 @@ private:
     // 백엔드 전송 콜백 (추가)
     std::function<void(const UnifiedRecord&)> m_backend_callback;
     
-    // 타임스탬프로부터 시간 슬롯 계산
-    std::string getTimeSlot(const std::string& timestamp);
+    // 타임스탬프(epoch 나노초)로부터 시간 슬롯 계산
+    std::string getTimeSlot(int64_t ts_ns);
     
     // 시간 슬롯별 파일 작성
     void writeTimeSlot(const std::string& time_slot);
@@ -0,0 +1,119 @@
+#include "CaptureEventLoop.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+int CaptureEventLoop::s_shutdown_fd = -1;
+
+CaptureEventLoop::CaptureEventLoop(int timeout_ms)
+    : m_timeout_ms(timeout_ms > 0 ? timeout_ms : -1) {}
+
+CaptureEventLoop::~CaptureEventLoop() {
+    close();
+}
+
+bool CaptureEventLoop::initShutdownEvent() {
+    if (s_shutdown_fd >= 0) return true;
+
+    s_shutdown_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s_shutdown_fd < 0) {
+        std::cerr << "[ERROR] eventfd failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void CaptureEventLoop::requestShutdown() {
+    if (s_shutdown_fd < 0) return;
+
+    // 값을 읽어 가지 않으므로 level-triggered로 모든 루프에서 계속 readable
+    int saved_errno = errno;
+    uint64_t one = 1;
+    ssize_t written = write(s_shutdown_fd, &one, sizeof(one));
+    (void)written;
+    errno = saved_errno;
+}
+
+bool CaptureEventLoop::isShutdownRequested() {
+    if (s_shutdown_fd < 0) return false;
+
+    struct pollfd pfd;
+    pfd.fd = s_shutdown_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+}
+
+bool CaptureEventLoop::open(int capture_fd) {
+    if (!initShutdownEvent()) return false;
+
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd < 0) {
+        std::cerr << "[ERROR] epoll_create1 failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = s_shutdown_fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, s_shutdown_fd, &ev) < 0) {
+        std::cerr << "[ERROR] epoll_ctl(shutdown eventfd) failed: " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    if (capture_fd >= 0) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = capture_fd;
+        if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, capture_fd, &ev) < 0) {
+            std::cerr << "[ERROR] epoll_ctl(capture fd) failed: " << strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+    }
+    m_capture_fd = capture_fd;
+    return true;
+}
+
+void CaptureEventLoop::close() {
+    if (m_epoll_fd >= 0) {
+        ::close(m_epoll_fd);
+        m_epoll_fd = -1;
+    }
+    m_capture_fd = -1;
+}
+
+CaptureEventLoop::WaitResult CaptureEventLoop::wait() {
+    if (m_epoll_fd < 0) return WAIT_ERROR;
+
+    struct epoll_event events[2];
+    int n = epoll_wait(m_epoll_fd, events, 2, m_timeout_ms);
+    if (n < 0) {
+        // signal handler가 실행되면 EINTR로 깨어남 -> 종료 eventfd는 다음 wait에서 확인
+        if (errno == EINTR) {
+            return isShutdownRequested() ? SHUTDOWN : TIMEOUT;
+        }
+        std::cerr << "[ERROR] epoll_wait failed: " << strerror(errno) << std::endl;
+        return WAIT_ERROR;
+    }
+    if (n == 0) return TIMEOUT;
+
+    bool ready = false;
+    for (int i = 0; i < n; ++i) {
+        if (events[i].data.fd == s_shutdown_fd) {
+            return SHUTDOWN;
+        }
+        if (events[i].data.fd == m_capture_fd) {
+            ready = true;
+        }
+    }
+    return ready ? READY : TIMEOUT;
+}
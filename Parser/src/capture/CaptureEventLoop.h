@@ -0,0 +1,44 @@
+#ifndef CAPTURE_EVENT_LOOP_H
+#define CAPTURE_EVENT_LOOP_H
+
+// 캡처 fd와 종료 eventfd를 epoll로 함께 대기하는 이벤트 루프
+// 패킷이 없을 때 sleep polling 대신 커널이 깨워 줄 때까지 블록하고,
+// SIGINT/SIGTERM이 오면 requestShutdown()이 모든 루프를 즉시 깨웁니다.
+class CaptureEventLoop {
+public:
+    enum WaitResult {
+        READY,       // 캡처 fd에 읽을 데이터 있음
+        TIMEOUT,     // timeout 경과 (통계 출력 등 주기 작업용)
+        SHUTDOWN,    // 종료 요청
+        WAIT_ERROR
+    };
+
+    explicit CaptureEventLoop(int timeout_ms);
+    ~CaptureEventLoop();
+
+    CaptureEventLoop(const CaptureEventLoop&) = delete;
+    CaptureEventLoop& operator=(const CaptureEventLoop&) = delete;
+
+    // capture_fd가 -1이면 종료 이벤트만 대기 (캡처를 worker가 담당하는 경우)
+    bool open(int capture_fd);
+    void close();
+
+    WaitResult wait();
+
+    // 프로세스 공통 종료 eventfd (signal handler 등록 전에 한 번 생성)
+    static bool initShutdownEvent();
+    // async-signal-safe: signal handler에서 호출 가능
+    static void requestShutdown();
+    static bool isShutdownRequested();
+    // 백엔드가 자체 대기 중에도 종료 요청에 깨어날 수 있도록 공개 (없으면 -1)
+    static int shutdownFd() { return s_shutdown_fd; }
+
+private:
+    int m_epoll_fd = -1;
+    int m_capture_fd = -1;
+    int m_timeout_ms;
+
+    static int s_shutdown_fd;
+};
+
+#endif // CAPTURE_EVENT_LOOP_H
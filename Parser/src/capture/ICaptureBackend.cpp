@@ -0,0 +1,15 @@
+#include "ICaptureBackend.h"
+#include "PcapCaptureBackend.h"
+#include "TpacketV3CaptureBackend.h"
+
+ICaptureBackend::~ICaptureBackend() {}
+
+std::unique_ptr<ICaptureBackend> createCaptureBackend(const CaptureConfig& config) {
+    if (config.backend == "pcap") {
+        return std::make_unique<PcapCaptureBackend>(config);
+    }
+    if (config.backend == "tpacket_v3") {
+        return std::make_unique<TpacketV3CaptureBackend>(config);
+    }
+    return nullptr;
+}
@@ -0,0 +1,76 @@
+#ifndef ICAPTURE_BACKEND_H
+#define ICAPTURE_BACKEND_H
+
+#include <pcap.h>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// 캡처 백엔드 설정
+struct CaptureConfig {
+    std::string backend = "pcap";        // "pcap" | "tpacket_v3"
+    std::string interface = "any";
+    int snaplen = 65535;
+    bool promiscuous = true;
+    int read_timeout_ms = 1000;
+    int buffer_size = 0;                 // 커널 캡처 버퍼 (bytes, 0 = libpcap 기본값)
+    bool immediate_mode = false;         // 버퍼링 없이 패킷 도착 즉시 전달
+    bool nano_precision = false;         // true면 pcap_pkthdr.ts.tv_usec에 나노초를 담음
+    int poll_timeout_ms = 1000;          // epoll 대기 최대 시간 (패킷이 없을 때 주기 작업 확인용)
+
+    // TPACKET_V3 block ring 설정
+    int block_size = 1 << 22;            // 4 MiB (페이지 크기의 배수)
+    int block_count = 64;                // ring 전체 크기 = block_size * block_count
+    int retire_timeout_ms = 60;          // 블록이 가득 차지 않아도 사용자에게 넘기는 시간
+
+    // PACKET_FANOUT 설정 (TPACKET_V3 전용, 비어 있으면 단일 소켓)
+    // 소켓마다 위 block ring을 하나씩 가지며, 각 소켓은 worker 하나에 고정됩니다.
+    std::string fanout_mode;             // "hash" | "cpu" | "lb" | "qm"
+    int fanout_group_id = 0;             // 같은 인터페이스에서 다른 프로세스와 겹치지 않는 값
+};
+
+// 캡처 통계 (누적값)
+struct CaptureStats {
+    uint64_t packets_received = 0;
+    uint64_t packets_dropped = 0;        // 커널 드롭
+    uint64_t ring_freezes = 0;           // TPACKET_V3: ring이 가득 차 멈춘 횟수
+};
+
+// 백엔드 버퍼(예: ring 블록)를 worker가 처리를 마칠 때까지 붙잡아 두는 참조
+// handler가 lease를 받으면 패킷 처리 후 반드시 release()를 한 번 호출해야 합니다.
+class PacketLease {
+public:
+    virtual ~PacketLease() = default;
+    virtual void release() = 0;
+};
+
+// lease가 nullptr이면 packet 포인터는 handler 호출 동안만 유효 (호출자가 복사해야 함)
+typedef void (*PacketHandler)(u_char* user, const struct pcap_pkthdr* header,
+                              const u_char* packet, PacketLease* lease);
+
+class ICaptureBackend {
+public:
+    virtual ~ICaptureBackend();
+
+    virtual std::string getName() const = 0;
+
+    virtual bool open() = 0;
+    virtual void close() = 0;
+    virtual bool setFilter(const std::string& bpf_filter) = 0;
+
+    // 준비된 패킷을 handler로 전달합니다.
+    // 반환값: 처리한 패킷 수, 준비된 패킷이 없으면 0, 오류 시 -1
+    virtual int dispatch(int max_packets, PacketHandler handler, u_char* user) = 0;
+
+    // poll/epoll 대기에 사용할 fd
+    virtual int getSelectableFd() const = 0;
+    virtual int getDatalink() const = 0;
+    // 실제 적용된 timestamp 정밀도 (PCAP_TSTAMP_PRECISION_MICRO | PCAP_TSTAMP_PRECISION_NANO)
+    virtual int getTimestampPrecision() const = 0;
+    virtual bool getStats(CaptureStats& stats) = 0;
+};
+
+// config.backend에 맞는 백엔드 생성 (알 수 없는 이름이면 nullptr)
+std::unique_ptr<ICaptureBackend> createCaptureBackend(const CaptureConfig& config);
+
+#endif // ICAPTURE_BACKEND_H
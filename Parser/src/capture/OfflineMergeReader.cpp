@@ -0,0 +1,166 @@
+#include "OfflineMergeReader.h"
+#include <iostream>
+#include <algorithm>
+
+#include <glob.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace {
+
+bool hasCaptureExtension(const std::string& name) {
+    static const char* extensions[] = {".pcap", ".pcapng", ".cap"};
+    for (const char* ext : extensions) {
+        size_t len = std::char_traits<char>::length(ext);
+        if (name.size() > len && name.compare(name.size() - len, len, ext) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void appendDirectory(const std::string& dir, std::vector<std::string>& files) {
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        std::cerr << "[WARN] Could not read directory " << dir << std::endl;
+        return;
+    }
+
+    std::vector<std::string> entries;
+    while (struct dirent* entry = readdir(d)) {
+        std::string name = entry->d_name;
+        if (name[0] == '.' || !hasCaptureExtension(name)) continue;
+
+        std::string path = dir + (dir.back() == '/' ? "" : "/") + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            entries.push_back(path);
+        }
+    }
+    closedir(d);
+
+    std::sort(entries.begin(), entries.end());
+    files.insert(files.end(), entries.begin(), entries.end());
+}
+
+} // namespace
+
+OfflineMergeReader::OfflineMergeReader(bool nano_precision)
+    : m_nano(nano_precision) {}
+
+std::vector<std::string> OfflineMergeReader::expandInputs(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+
+    for (const auto& input : inputs) {
+        struct stat st;
+        if (stat(input.c_str(), &st) == 0) {
+            if (S_ISDIR(st.st_mode)) {
+                appendDirectory(input, files);
+            } else {
+                files.push_back(input);
+            }
+            continue;
+        }
+
+        // 존재하지 않는 경로는 glob 패턴으로 해석 (따옴표로 넘긴 경우)
+        glob_t g;
+        if (glob(input.c_str(), 0, nullptr, &g) == 0) {
+            for (size_t i = 0; i < g.gl_pathc; ++i) {
+                files.push_back(g.gl_pathv[i]);
+            }
+        } else {
+            std::cerr << "[WARN] No capture files match " << input << std::endl;
+        }
+        globfree(&g);
+    }
+
+    // 같은 파일을 두 번 읽지 않도록 중복 제거 (처음 나온 순서 유지)
+    std::vector<std::string> unique;
+    for (const auto& file : files) {
+        if (std::find(unique.begin(), unique.end(), file) == unique.end()) {
+            unique.push_back(file);
+        }
+    }
+    return unique;
+}
+
+bool OfflineMergeReader::open(const std::vector<std::string>& paths) {
+    close();
+
+    for (const auto& path : paths) {
+        auto reader = std::make_unique<OfflinePcapReader>(m_nano);
+        if (!reader->open(path)) {
+            close();
+            return false;
+        }
+        m_readers.push_back(std::move(reader));
+    }
+    return !m_readers.empty();
+}
+
+void OfflineMergeReader::close() {
+    m_heap = decltype(m_heap)();
+    m_readers.clear();
+    m_primed = false;
+}
+
+bool OfflineMergeReader::setFilter(const std::string& bpf_filter) {
+    for (auto& reader : m_readers) {
+        if (!reader->setFilter(bpf_filter)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void OfflineMergeReader::prime() {
+    for (size_t i = 0; i < m_readers.size(); ++i) {
+        Cursor cursor;
+        cursor.source = i;
+        if (m_readers[i]->next(cursor.packet)) {
+            m_heap.push(cursor);
+        }
+    }
+    m_primed = true;
+}
+
+bool OfflineMergeReader::nextChunk(OfflineChunk& chunk, size_t max_packets) {
+    chunk.clear();
+
+    // 파일이 하나면 merge 없이 그대로 읽음
+    if (m_readers.size() == 1) {
+        return m_readers[0]->nextChunk(chunk, max_packets);
+    }
+
+    if (!m_primed) prime();
+
+    chunk.reserve(max_packets);
+    while (chunk.size() < max_packets && !m_heap.empty()) {
+        Cursor cursor = m_heap.top();
+        m_heap.pop();
+        chunk.push_back(cursor.packet);
+
+        if (m_readers[cursor.source]->next(cursor.packet)) {
+            m_heap.push(cursor);
+        }
+    }
+    return !chunk.empty();
+}
+
+size_t OfflineMergeReader::getTotalSize() const {
+    size_t total = 0;
+    for (const auto& reader : m_readers) total += reader->getFileSize();
+    return total;
+}
+
+uint64_t OfflineMergeReader::getPacketsRead() const {
+    uint64_t total = 0;
+    for (const auto& reader : m_readers) total += reader->getPacketsRead();
+    return total;
+}
+
+uint64_t OfflineMergeReader::getPacketsFiltered() const {
+    uint64_t total = 0;
+    for (const auto& reader : m_readers) total += reader->getPacketsFiltered();
+    return total;
+}
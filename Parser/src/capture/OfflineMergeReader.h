@@ -0,0 +1,56 @@
+#ifndef OFFLINE_MERGE_READER_H
+#define OFFLINE_MERGE_READER_H
+
+#include "OfflinePcapReader.h"
+#include <memory>
+#include <queue>
+
+// 여러 캡처 파일을 동시에 mmap해서 capture timestamp 순으로 k-way merge하는 reader
+// 파일 경계와 상관없이 시간 순서가 유지되므로 UnifiedWriter time slot이 어긋나지 않습니다.
+class OfflineMergeReader {
+public:
+    explicit OfflineMergeReader(bool nano_precision = false);
+
+    // 파일, glob 패턴, 디렉토리(*.pcap, *.pcapng, *.cap)를 파일 목록으로 펼침 (정렬, 중복 제거)
+    static std::vector<std::string> expandInputs(const std::vector<std::string>& inputs);
+
+    // 모든 파일을 열어야 성공 (하나라도 실패하면 false)
+    bool open(const std::vector<std::string>& paths);
+    void close();
+    bool setFilter(const std::string& bpf_filter);
+
+    bool nextChunk(OfflineChunk& chunk, size_t max_packets);
+
+    size_t getFileCount() const { return m_readers.size(); }
+    const OfflinePcapReader& getReader(size_t index) const { return *m_readers[index]; }
+    size_t getTotalSize() const;
+    uint64_t getPacketsRead() const;
+    uint64_t getPacketsFiltered() const;
+
+private:
+    struct Cursor {
+        OfflinePacket packet;
+        size_t source;
+    };
+
+    // priority_queue는 최대 힙이므로 "나중" 패킷이 더 큰 것으로 비교
+    // timestamp가 같으면 파일 순서를 유지
+    struct Later {
+        bool operator()(const Cursor& a, const Cursor& b) const {
+            if (a.packet.header.ts.tv_sec != b.packet.header.ts.tv_sec)
+                return a.packet.header.ts.tv_sec > b.packet.header.ts.tv_sec;
+            if (a.packet.header.ts.tv_usec != b.packet.header.ts.tv_usec)
+                return a.packet.header.ts.tv_usec > b.packet.header.ts.tv_usec;
+            return a.source > b.source;
+        }
+    };
+
+    bool m_nano;
+    std::vector<std::unique_ptr<OfflinePcapReader>> m_readers;
+    std::priority_queue<Cursor, std::vector<Cursor>, Later> m_heap;
+    bool m_primed = false;
+
+    void prime();
+};
+
+#endif // OFFLINE_MERGE_READER_H
@@ -0,0 +1,414 @@
+#include "OfflinePcapReader.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const uint32_t PCAP_MAGIC_MICRO = 0xa1b2c3d4;
+const uint32_t PCAP_MAGIC_NANO = 0xa1b23c4d;
+const uint32_t PCAPNG_SHB = 0x0A0D0D0A;
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+const uint32_t PCAPNG_IDB = 1;
+const uint32_t PCAPNG_PB = 2;    // obsolete Packet Block
+const uint32_t PCAPNG_SPB = 3;
+const uint32_t PCAPNG_EPB = 6;
+
+const size_t PCAP_FILE_HEADER_LEN = 24;
+const size_t PCAP_RECORD_HEADER_LEN = 16;
+
+// LINKTYPE_* 값 중 DLT_*와 다른 것만 변환
+int linktypeToDlt(uint32_t linktype) {
+    if (linktype == 101) return DLT_RAW;   // LINKTYPE_RAW
+    return static_cast<int>(linktype);
+}
+
+} // namespace
+
+OfflinePcapReader::OfflinePcapReader(bool nano_precision)
+    : m_nano(nano_precision) {}
+
+OfflinePcapReader::~OfflinePcapReader() {
+    close();
+}
+
+uint16_t OfflinePcapReader::read16(const uint8_t* p) const {
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return m_swapped ? __builtin_bswap16(v) : v;
+}
+
+uint32_t OfflinePcapReader::read32(const uint8_t* p) const {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return m_swapped ? __builtin_bswap32(v) : v;
+}
+
+uint64_t OfflinePcapReader::read64(const uint8_t* p) const {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return m_swapped ? __builtin_bswap64(v) : v;
+}
+
+bool OfflinePcapReader::open(const std::string& path) {
+    close();
+    m_path = path;
+
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        std::cerr << "[ERROR] Could not open PCAP file " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(m_fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(uint32_t))) {
+        std::cerr << "[ERROR] PCAP file " << path << " is empty or unreadable" << std::endl;
+        close();
+        return false;
+    }
+    m_size = static_cast<size_t>(st.st_size);
+
+    void* map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (map == MAP_FAILED) {
+        std::cerr << "[ERROR] mmap of " << path << " failed: " << strerror(errno) << std::endl;
+        m_size = 0;
+        close();
+        return false;
+    }
+    m_base = static_cast<const uint8_t*>(map);
+    madvise(map, m_size, MADV_SEQUENTIAL);
+
+    uint32_t magic;
+    memcpy(&magic, m_base, sizeof(magic));
+
+    bool ok;
+    if (magic == PCAPNG_SHB) {
+        m_pcapng = true;
+        ok = parseSectionHeader(0);
+    } else {
+        ok = parsePcapHeader();
+    }
+
+    if (!ok) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void OfflinePcapReader::close() {
+    freePrograms();
+
+    if (m_base) {
+        munmap(const_cast<uint8_t*>(m_base), m_size);
+        m_base = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    m_size = 0;
+    m_offset = 0;
+    m_pcapng = false;
+    m_swapped = false;
+    m_file_nano = false;
+    m_linktype = DLT_EN10MB;
+    m_interfaces.clear();
+    m_packets_read = 0;
+    m_packets_filtered = 0;
+}
+
+bool OfflinePcapReader::parsePcapHeader() {
+    if (m_size < PCAP_FILE_HEADER_LEN) {
+        std::cerr << "[ERROR] " << m_path << ": truncated pcap header" << std::endl;
+        return false;
+    }
+
+    uint32_t magic;
+    memcpy(&magic, m_base, sizeof(magic));
+
+    if (magic == PCAP_MAGIC_MICRO || magic == PCAP_MAGIC_NANO) {
+        m_swapped = false;
+    } else if (magic == __builtin_bswap32(PCAP_MAGIC_MICRO) || magic == __builtin_bswap32(PCAP_MAGIC_NANO)) {
+        m_swapped = true;
+    } else {
+        std::cerr << "[ERROR] " << m_path << ": unknown capture file format" << std::endl;
+        return false;
+    }
+
+    m_file_nano = (read32(m_base) == PCAP_MAGIC_NANO);
+    // 상위 비트는 FCS 정보이므로 하위 16비트만 링크 타입
+    m_linktype = linktypeToDlt(read32(m_base + 20) & 0xffff);
+    m_offset = PCAP_FILE_HEADER_LEN;
+    return true;
+}
+
+bool OfflinePcapReader::parseSectionHeader(size_t offset) {
+    // type(4) + length(4) + byte-order magic(4) + version(4) + section length(8)
+    if (offset + 28 > m_size) {
+        std::cerr << "[ERROR] " << m_path << ": truncated pcapng section header" << std::endl;
+        return false;
+    }
+
+    const uint8_t* block = m_base + offset;
+    uint32_t bom;
+    memcpy(&bom, block + 8, sizeof(bom));
+    if (bom == PCAPNG_BYTE_ORDER_MAGIC) {
+        m_swapped = false;
+    } else if (bom == __builtin_bswap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+        m_swapped = true;
+    } else {
+        std::cerr << "[ERROR] " << m_path << ": invalid pcapng byte-order magic" << std::endl;
+        return false;
+    }
+
+    uint32_t block_len = read32(block + 4);
+    if (block_len < 28 || block_len % 4 != 0 || offset + block_len > m_size) {
+        std::cerr << "[ERROR] " << m_path << ": invalid pcapng section header length" << std::endl;
+        return false;
+    }
+
+    // 인터페이스 ID는 섹션마다 0부터 다시 시작
+    m_interfaces.clear();
+    m_offset = offset + block_len;
+    return true;
+}
+
+void OfflinePcapReader::parseInterfaceBlock(const uint8_t* body, size_t body_len) {
+    if (body_len < 8) return;
+
+    Interface iface;
+    iface.linktype = linktypeToDlt(read16(body));
+    iface.ts_units = 1000000;
+    iface.ts_offset = 0;
+
+    size_t pos = 8;
+    while (pos + 4 <= body_len) {
+        uint16_t code = read16(body + pos);
+        uint16_t len = read16(body + pos + 2);
+        if (code == 0 || pos + 4 + len > body_len) break;
+
+        const uint8_t* value = body + pos + 4;
+        if (code == 9 && len >= 1) {
+            // if_tsresol: MSB가 0이면 10^-n, 1이면 2^-n 초
+            uint8_t resol = value[0];
+            uint8_t exp = resol & 0x7f;
+            if (resol & 0x80) {
+                iface.ts_units = exp < 64 ? (1ULL << exp) : 1000000;
+            } else if (exp <= 19) {
+                iface.ts_units = 1;
+                for (uint8_t i = 0; i < exp; ++i) iface.ts_units *= 10;
+            }
+        } else if (code == 14 && len >= 8) {
+            iface.ts_offset = static_cast<int64_t>(read64(value));
+        }
+        pos += 4 + ((len + 3u) & ~3u);
+    }
+
+    if (m_interfaces.empty()) {
+        m_linktype = iface.linktype;
+    }
+    m_interfaces.push_back(iface);
+}
+
+void OfflinePcapReader::setTimestamp(OfflinePacket& packet, uint64_t ts, const Interface& iface) const {
+    const uint64_t target = m_nano ? 1000000000ULL : 1000000ULL;
+    uint64_t units = iface.ts_units ? iface.ts_units : 1000000ULL;
+
+    uint64_t rem = ts % units;
+    packet.header.ts.tv_sec = static_cast<time_t>(static_cast<int64_t>(ts / units) + iface.ts_offset);
+    packet.header.ts.tv_usec = static_cast<suseconds_t>(
+        static_cast<unsigned __int128>(rem) * target / units);
+}
+
+bool OfflinePcapReader::nextPcapRecord(OfflinePacket& packet) {
+    if (m_offset + PCAP_RECORD_HEADER_LEN > m_size) {
+        if (m_offset < m_size) {
+            std::cerr << "[WARN] " << m_path << ": truncated record header at offset " << m_offset << std::endl;
+            m_offset = m_size;
+        }
+        return false;
+    }
+
+    const uint8_t* rec = m_base + m_offset;
+    uint32_t ts_sec = read32(rec);
+    uint32_t ts_frac = read32(rec + 4);
+    uint32_t caplen = read32(rec + 8);
+    uint32_t len = read32(rec + 12);
+
+    if (m_offset + PCAP_RECORD_HEADER_LEN + caplen > m_size) {
+        std::cerr << "[WARN] " << m_path << ": truncated record at offset " << m_offset << std::endl;
+        m_offset = m_size;
+        return false;
+    }
+
+    if (m_nano && !m_file_nano) {
+        ts_frac *= 1000;
+    } else if (!m_nano && m_file_nano) {
+        ts_frac /= 1000;
+    }
+
+    packet.header.ts.tv_sec = static_cast<time_t>(ts_sec);
+    packet.header.ts.tv_usec = static_cast<suseconds_t>(ts_frac);
+    packet.header.caplen = caplen;
+    packet.header.len = len;
+    packet.data = rec + PCAP_RECORD_HEADER_LEN;
+    packet.linktype = m_linktype;
+
+    m_offset += PCAP_RECORD_HEADER_LEN + caplen;
+    return true;
+}
+
+bool OfflinePcapReader::nextPcapngRecord(OfflinePacket& packet) {
+    while (m_offset + 12 <= m_size) {
+        const uint8_t* block = m_base + m_offset;
+
+        // SHB는 byte order를 바꿀 수 있으므로 길이보다 먼저 확인 (type 값은 대칭)
+        uint32_t raw_type;
+        memcpy(&raw_type, block, sizeof(raw_type));
+        if (raw_type == PCAPNG_SHB) {
+            if (!parseSectionHeader(m_offset)) {
+                m_offset = m_size;
+                return false;
+            }
+            continue;
+        }
+
+        uint32_t type = read32(block);
+        uint32_t block_len = read32(block + 4);
+        if (block_len < 12 || block_len % 4 != 0 || m_offset + block_len > m_size) {
+            std::cerr << "[WARN] " << m_path << ": truncated pcapng block at offset " << m_offset << std::endl;
+            m_offset = m_size;
+            return false;
+        }
+
+        const uint8_t* body = block + 8;
+        size_t body_len = block_len - 12;
+        m_offset += block_len;
+
+        if (type == PCAPNG_IDB) {
+            parseInterfaceBlock(body, body_len);
+        } else if (type == PCAPNG_EPB || type == PCAPNG_PB) {
+            // EPB: interface_id(4), PB: interface_id(2) + drops_count(2)
+            if (body_len < 20) continue;
+            uint32_t iface_id = (type == PCAPNG_EPB) ? read32(body) : read16(body);
+            uint32_t caplen = read32(body + 12);
+            if (iface_id >= m_interfaces.size() || caplen > body_len - 20) continue;
+
+            const Interface& iface = m_interfaces[iface_id];
+            uint64_t ts = (static_cast<uint64_t>(read32(body + 4)) << 32) | read32(body + 8);
+            setTimestamp(packet, ts, iface);
+            packet.header.caplen = caplen;
+            packet.header.len = read32(body + 16);
+            packet.data = body + 20;
+            packet.linktype = iface.linktype;
+            return true;
+        } else if (type == PCAPNG_SPB) {
+            // SPB는 timestamp가 없고 항상 인터페이스 0
+            if (body_len < 4 || m_interfaces.empty()) continue;
+            uint32_t len = read32(body);
+            uint32_t caplen = static_cast<uint32_t>(body_len - 4);
+            if (len < caplen) caplen = len;
+
+            setTimestamp(packet, 0, m_interfaces[0]);
+            packet.header.caplen = caplen;
+            packet.header.len = len;
+            packet.data = body + 4;
+            packet.linktype = m_interfaces[0].linktype;
+            return true;
+        }
+        // 그 외 블록 (NRB, ISB, DSB 등)은 건너뜀
+    }
+
+    m_offset = m_size;
+    return false;
+}
+
+bool OfflinePcapReader::next(OfflinePacket& packet) {
+    if (!m_base) return false;
+
+    while (m_pcapng ? nextPcapngRecord(packet) : nextPcapRecord(packet)) {
+        m_packets_read++;
+        if (passesFilter(packet)) {
+            return true;
+        }
+        m_packets_filtered++;
+    }
+    return false;
+}
+
+bool OfflinePcapReader::nextChunk(OfflineChunk& chunk, size_t max_packets) {
+    chunk.clear();
+    chunk.reserve(max_packets);
+
+    OfflinePacket packet;
+    while (chunk.size() < max_packets && next(packet)) {
+        chunk.push_back(packet);
+    }
+    return !chunk.empty();
+}
+
+bool OfflinePcapReader::setFilter(const std::string& bpf_filter) {
+    freePrograms();
+    m_filter = bpf_filter;
+    if (m_filter.empty()) return true;
+
+    // 첫 인터페이스의 링크 타입으로 미리 컴파일해서 문법 오류를 바로 보고
+    pcap_t* dead = pcap_open_dead(m_linktype, 262144);
+    if (!dead) {
+        std::cerr << "[ERROR] pcap_open_dead failed" << std::endl;
+        return false;
+    }
+
+    struct bpf_program fp;
+    if (pcap_compile(dead, &fp, m_filter.c_str(), 1, PCAP_NETMASK_UNKNOWN) == -1) {
+        std::cerr << "[ERROR] Could not compile filter: " << pcap_geterr(dead) << std::endl;
+        pcap_close(dead);
+        m_filter.clear();
+        return false;
+    }
+    pcap_close(dead);
+
+    m_programs[m_linktype] = fp;
+    return true;
+}
+
+bool OfflinePcapReader::passesFilter(const OfflinePacket& packet) {
+    if (m_filter.empty()) return true;
+
+    auto it = m_programs.find(packet.linktype);
+    if (it == m_programs.end()) {
+        // pcapng에서 새 링크 타입이 나오면 그때 컴파일 (실패하면 해당 링크 타입은 모두 제외)
+        struct bpf_program fp;
+        memset(&fp, 0, sizeof(fp));
+        pcap_t* dead = pcap_open_dead(packet.linktype, 262144);
+        if (dead) {
+            if (pcap_compile(dead, &fp, m_filter.c_str(), 1, PCAP_NETMASK_UNKNOWN) == -1) {
+                std::cerr << "[WARN] Filter not applicable to link type " << packet.linktype
+                          << ": " << pcap_geterr(dead) << std::endl;
+                memset(&fp, 0, sizeof(fp));
+            }
+            pcap_close(dead);
+        }
+        it = m_programs.emplace(packet.linktype, fp).first;
+    }
+
+    if (it->second.bf_insns == nullptr) return false;
+    return pcap_offline_filter(&it->second, &packet.header, packet.data) != 0;
+}
+
+void OfflinePcapReader::freePrograms() {
+    for (auto& entry : m_programs) {
+        if (entry.second.bf_insns) {
+            pcap_freecode(&entry.second);
+        }
+    }
+    m_programs.clear();
+}
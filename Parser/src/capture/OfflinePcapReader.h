@@ -0,0 +1,94 @@
+#ifndef OFFLINE_PCAP_READER_H
+#define OFFLINE_PCAP_READER_H
+
+#include <pcap.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+// mmap된 캡처 파일 안의 패킷 하나 (data는 파일 매핑을 직접 가리킴)
+struct OfflinePacket {
+    struct pcap_pkthdr header;   // ts.tv_usec는 reader 정밀도(마이크로/나노초)
+    const u_char* data;
+    int linktype;                // pcapng는 인터페이스마다 다를 수 있음
+};
+
+// worker가 한 번에 가져가 처리하는 레코드 단위 묶음
+typedef std::vector<OfflinePacket> OfflineChunk;
+
+// pcap / pcapng 파일을 mmap해서 복사 없이 레코드를 순회하는 reader
+// 레코드 경계는 순차적으로만 알 수 있으므로 헤더만 훑어 chunk를 만들고,
+// 실제 디코딩은 worker들이 chunk 단위로 병렬 처리합니다.
+// chunk의 패킷은 close() 전까지 유효합니다.
+class OfflinePcapReader {
+public:
+    explicit OfflinePcapReader(bool nano_precision = false);
+    ~OfflinePcapReader();
+
+    OfflinePcapReader(const OfflinePcapReader&) = delete;
+    OfflinePcapReader& operator=(const OfflinePcapReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    // 링크 타입별로 컴파일해서 pcap_offline_filter로 적용
+    bool setFilter(const std::string& bpf_filter);
+
+    // 다음 패킷 (필터에 걸러진 패킷은 건너뜀). 파일 끝이거나 손상된 레코드면 false
+    bool next(OfflinePacket& packet);
+    // 최대 max_packets개를 chunk에 채움. 더 읽을 패킷이 없으면 false
+    bool nextChunk(OfflineChunk& chunk, size_t max_packets);
+
+    const std::string& getPath() const { return m_path; }
+    const char* getFormat() const { return m_pcapng ? "pcapng" : "pcap"; }
+    int getDatalink() const { return m_linktype; }
+    size_t getFileSize() const { return m_size; }
+    size_t getOffset() const { return m_offset; }
+    uint64_t getPacketsRead() const { return m_packets_read; }
+    uint64_t getPacketsFiltered() const { return m_packets_filtered; }
+
+private:
+    // pcapng 인터페이스 (IDB) 정보
+    struct Interface {
+        int linktype;
+        uint64_t ts_units;       // 초당 timestamp 단위 수 (if_tsresol)
+        int64_t ts_offset;       // if_tsoffset (초)
+    };
+
+    bool m_nano;
+    std::string m_path;
+    int m_fd = -1;
+    const uint8_t* m_base = nullptr;
+    size_t m_size = 0;
+    size_t m_offset = 0;
+
+    bool m_pcapng = false;
+    bool m_swapped = false;      // 파일 byte order가 호스트와 다름
+    bool m_file_nano = false;    // pcap: 나노초 magic
+    int m_linktype = DLT_EN10MB;
+    std::vector<Interface> m_interfaces;
+
+    std::string m_filter;
+    std::map<int, struct bpf_program> m_programs;
+
+    uint64_t m_packets_read = 0;
+    uint64_t m_packets_filtered = 0;
+
+    uint16_t read16(const uint8_t* p) const;
+    uint32_t read32(const uint8_t* p) const;
+    uint64_t read64(const uint8_t* p) const;
+
+    bool parsePcapHeader();
+    bool parseSectionHeader(size_t offset);
+    void parseInterfaceBlock(const uint8_t* body, size_t body_len);
+
+    bool nextPcapRecord(OfflinePacket& packet);
+    bool nextPcapngRecord(OfflinePacket& packet);
+    void setTimestamp(OfflinePacket& packet, uint64_t ts, const Interface& iface) const;
+    bool passesFilter(const OfflinePacket& packet);
+    void freePrograms();
+};
+
+#endif // OFFLINE_PCAP_READER_H
@@ -0,0 +1,147 @@
+#include "PacketPool.h"
+#include "../ThreadPlacement.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace {
+
+const size_t DEFAULT_SLOT_BYTES = 2048;
+const size_t HUGEPAGE_SIZE = 2 * 1024 * 1024;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+PacketPool::PacketPool()
+    : m_region(nullptr),
+      m_region_size(0),
+      m_slots(nullptr),
+      m_slot_count(0),
+      m_slot_bytes(0),
+      m_hugepages(false),
+      m_free_head(nullptr) {}
+
+PacketPool::~PacketPool() {
+    close();
+}
+
+bool PacketPool::open(const PacketPoolConfig& config, int snaplen) {
+    close();
+
+    if (config.slots == 0) {
+        std::cerr << "[ERROR] Packet pool needs at least one slot" << std::endl;
+        return false;
+    }
+
+    // 일반적인 프레임은 슬롯 버퍼에, 그보다 큰 패킷(GRO 등)은 overflow로 처리
+    size_t slot_bytes = config.slot_bytes;
+    if (slot_bytes == 0) {
+        slot_bytes = std::min(static_cast<size_t>(snaplen > 0 ? snaplen : 65535), DEFAULT_SLOT_BYTES);
+    }
+    m_slot_bytes = alignUp(slot_bytes, PACKET_POOL_CACHE_LINE);
+    m_slot_count = config.slots;
+
+    size_t header_bytes = alignUp(m_slot_count * sizeof(PacketSlot), PACKET_POOL_CACHE_LINE);
+    size_t total = header_bytes + m_slot_count * m_slot_bytes;
+
+    if (config.hugepages) {
+        size_t huge_total = alignUp(total, HUGEPAGE_SIZE);
+        void* region = mmap(nullptr, huge_total, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (region != MAP_FAILED) {
+            m_region = region;
+            m_region_size = huge_total;
+            m_hugepages = true;
+        } else {
+            std::cerr << "[WARN] Hugepage packet pool unavailable (" << strerror(errno)
+                      << "), using regular pages" << std::endl;
+        }
+    }
+
+    if (!m_region) {
+        void* region = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            std::cerr << "[ERROR] Could not allocate packet pool (" << total << " bytes): "
+                      << strerror(errno) << std::endl;
+            return false;
+        }
+        m_region = region;
+        m_region_size = total;
+    }
+
+    // 첫 touch(아래 placement new) 전에 노드를 지정해야 페이지가 그 노드에 할당됨
+    if (config.numa_node >= 0) {
+        ThreadPlacement::bindMemory(m_region, m_region_size, config.numa_node);
+    }
+
+    m_slots = static_cast<PacketSlot*>(m_region);
+    u_char* buffers = static_cast<u_char*>(m_region) + header_bytes;
+
+    PacketSlot* head = nullptr;
+    for (size_t i = m_slot_count; i-- > 0;) {
+        PacketSlot* slot = new (&m_slots[i]) PacketSlot();
+        slot->buffer = buffers + i * m_slot_bytes;
+        slot->next_free = head;
+        head = slot;
+    }
+    m_free_head.store(head);
+
+    std::cout << "[INFO] Packet pool: " << m_slot_count << " slots x " << m_slot_bytes << " bytes ("
+              << (m_region_size / (1024 * 1024)) << " MiB" << (m_hugepages ? ", hugepages" : "")
+              << (config.numa_node >= 0 ? ", NUMA node " + std::to_string(config.numa_node) : std::string()) << ")"
+              << std::endl;
+    return true;
+}
+
+void PacketPool::close() {
+    if (!m_region) return;
+
+    for (size_t i = 0; i < m_slot_count; ++i) {
+        m_slots[i].~PacketSlot();
+    }
+    munmap(m_region, m_region_size);
+
+    m_region = nullptr;
+    m_region_size = 0;
+    m_slots = nullptr;
+    m_slot_count = 0;
+    m_hugepages = false;
+    m_free_head.store(nullptr);
+}
+
+PacketSlot* PacketPool::acquire() {
+    PacketSlot* head = m_free_head.load();
+    while (head && !m_free_head.compare_exchange_weak(head, head->next_free)) {
+    }
+    return head;
+}
+
+void PacketPool::release(PacketSlot* slot) {
+    slot->lease = nullptr;
+    slot->data = nullptr;
+
+    PacketSlot* head = m_free_head.load();
+    do {
+        slot->next_free = head;
+    } while (!m_free_head.compare_exchange_weak(head, slot));
+}
+
+void PacketPool::copyInto(PacketSlot* slot, const struct pcap_pkthdr* header, const u_char* packet) const {
+    slot->header = *header;
+    slot->lease = nullptr;
+
+    if (header->caplen <= m_slot_bytes) {
+        memcpy(slot->buffer, packet, header->caplen);
+        slot->data = slot->buffer;
+    } else {
+        slot->overflow.assign(packet, packet + header->caplen);
+        slot->data = slot->overflow.data();
+    }
+}
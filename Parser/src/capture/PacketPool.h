@@ -0,0 +1,69 @@
+#ifndef PACKET_POOL_H
+#define PACKET_POOL_H
+
+#include <pcap.h>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "ICaptureBackend.h"
+
+#define PACKET_POOL_CACHE_LINE 64
+
+// 큐에 들어가는 패킷 하나 (캐시 라인 정렬, 풀 영역 안에 미리 할당됨)
+struct alignas(PACKET_POOL_CACHE_LINE) PacketSlot {
+    struct pcap_pkthdr header;
+    const u_char* data = nullptr;      // 실제 패킷 바이트 (buffer, overflow 또는 백엔드 버퍼)
+    PacketLease* lease = nullptr;      // 백엔드 버퍼를 빌린 경우 처리 후 release
+    PacketSlot* next_free = nullptr;   // free list 링크
+    uint8_t traffic_class = 0;         // 과부하 드롭 통계용 (TrafficClass)
+    u_char* buffer = nullptr;          // 풀 영역 안의 고정 버퍼 (slot_bytes)
+    std::vector<u_char> overflow;      // slot_bytes보다 큰 패킷용 (한 번 커지면 계속 재사용)
+};
+
+struct PacketPoolConfig {
+    size_t slots = 8192;        // 동시에 큐에 있을 수 있는 최대 패킷 수
+    size_t slot_bytes = 0;      // 슬롯당 버퍼 크기 (0 = min(snaplen, 2048))
+    bool hugepages = false;     // MAP_HUGETLB (실패하면 일반 페이지로 fallback)
+    int numa_node = -1;         // 슬롯을 채우는 캡처 스레드의 NUMA 노드 (-1 = 커널 기본 정책)
+};
+
+// 고정 크기 패킷 슬롯 풀
+// 슬롯과 버퍼를 한 번에 mmap하고 free list로 재활용하므로 패킷마다 힙 할당이 없습니다.
+// acquire()는 캡처 스레드 하나에서만, release()는 여러 worker에서 동시에 호출할 수 있습니다.
+class PacketPool {
+public:
+    PacketPool();
+    ~PacketPool();
+
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    bool open(const PacketPoolConfig& config, int snaplen);
+    void close();
+
+    // 빈 슬롯이 없으면 nullptr
+    PacketSlot* acquire();
+    void release(PacketSlot* slot);
+
+    // 패킷을 슬롯에 복사 (slot_bytes보다 크면 overflow 버퍼 사용)
+    void copyInto(PacketSlot* slot, const struct pcap_pkthdr* header, const u_char* packet) const;
+
+    bool isOpen() const { return m_region != nullptr; }
+    size_t getSlotCount() const { return m_slot_count; }
+    size_t getSlotBytes() const { return m_slot_bytes; }
+    size_t getRegionSize() const { return m_region_size; }
+    bool usesHugepages() const { return m_hugepages; }
+
+private:
+    void* m_region;
+    size_t m_region_size;
+    PacketSlot* m_slots;
+    size_t m_slot_count;
+    size_t m_slot_bytes;
+    bool m_hugepages;
+
+    // Treiber stack: pop은 단일 스레드라 ABA가 생기지 않음
+    std::atomic<PacketSlot*> m_free_head;
+};
+
+#endif // PACKET_POOL_H
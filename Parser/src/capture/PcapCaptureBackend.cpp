@@ -0,0 +1,158 @@
+#include "PcapCaptureBackend.h"
+#include <iostream>
+
+namespace {
+
+struct DispatchContext {
+    PacketHandler handler;
+    u_char* user;
+};
+
+// libpcap 버퍼는 다음 dispatch에서 재사용되므로 lease 없이 전달
+void pcapTrampoline(u_char* user, const struct pcap_pkthdr* header, const u_char* packet) {
+    DispatchContext* ctx = reinterpret_cast<DispatchContext*>(user);
+    ctx->handler(ctx->user, header, packet, nullptr);
+}
+
+} // namespace
+
+PcapCaptureBackend::PcapCaptureBackend(const CaptureConfig& config)
+    : m_config(config) {}
+
+PcapCaptureBackend::~PcapCaptureBackend() {
+    close();
+}
+
+bool PcapCaptureBackend::open() {
+    char errbuf[PCAP_ERRBUF_SIZE];
+
+    m_handle = pcap_create(m_config.interface.c_str(), errbuf);
+    if (m_handle == nullptr) {
+        std::cerr << "[ERROR] Could not open device " << m_config.interface << ": " << errbuf << std::endl;
+        return false;
+    }
+
+    // pcap_activate() 전에만 설정 가능
+    pcap_set_snaplen(m_handle, m_config.snaplen);
+    pcap_set_promisc(m_handle, m_config.promiscuous ? 1 : 0);
+    pcap_set_timeout(m_handle, m_config.read_timeout_ms);
+    bool buffer_set = false;
+    if (m_config.buffer_size > 0) {
+        buffer_set = pcap_set_buffer_size(m_handle, m_config.buffer_size) == 0;
+        if (!buffer_set) {
+            std::cerr << "[WARN] pcap_set_buffer_size(" << m_config.buffer_size << ") failed" << std::endl;
+        }
+    }
+    bool immediate = false;
+    if (m_config.immediate_mode) {
+        immediate = pcap_set_immediate_mode(m_handle, 1) == 0;
+        if (!immediate) {
+            std::cerr << "[WARN] pcap_set_immediate_mode failed" << std::endl;
+        }
+    }
+    if (m_config.nano_precision && pcap_set_tstamp_precision(m_handle, PCAP_TSTAMP_PRECISION_NANO) != 0) {
+        std::cerr << "[WARN] Nanosecond timestamps not supported on " << m_config.interface
+                  << ", using microseconds" << std::endl;
+    }
+
+    int status = pcap_activate(m_handle);
+    if (status < 0) {
+        std::cerr << "[ERROR] Could not activate device " << m_config.interface << ": "
+                  << pcap_statustostr(status) << " (" << pcap_geterr(m_handle) << ")" << std::endl;
+        pcap_close(m_handle);
+        m_handle = nullptr;
+        return false;
+    }
+    if (status > 0) {
+        std::cerr << "[WARN] pcap_activate on " << m_config.interface << ": "
+                  << pcap_statustostr(status) << " (" << pcap_geterr(m_handle) << ")" << std::endl;
+    }
+
+    // 메인 루프에서 대기를 직접 관리하므로 non-blocking으로 사용
+    if (pcap_setnonblock(m_handle, 1, errbuf) == -1) {
+        std::cerr << "[WARN] pcap_setnonblock failed: " << errbuf << std::endl;
+    }
+
+    // snaplen/timestamp 정밀도는 활성화 후 실제 값, 나머지는 설정 호출이 성공한 경우만 반영
+    // (libpcap은 적용된 버퍼 크기를 알려 주지 않으므로 요청한 값으로 표시, 커널이 조정할 수 있음)
+    bool promisc = m_config.promiscuous && status != PCAP_WARNING_PROMISC_NOTSUP;
+    std::cout << "[PCAP] Opened " << m_config.interface << " (libpcap backend: snaplen "
+              << pcap_snapshot(m_handle) << ", buffer ";
+    if (buffer_set) {
+        std::cout << (m_config.buffer_size / 1024) << " KiB requested";
+    } else {
+        std::cout << "default";
+    }
+    std::cout << ", " << (immediate ? "immediate" : "buffered")
+              << ", " << (promisc ? "promisc" : "non-promisc")
+              << ", " << (getTimestampPrecision() == PCAP_TSTAMP_PRECISION_NANO ? "ns" : "us")
+              << " timestamps)" << std::endl;
+    return true;
+}
+
+void PcapCaptureBackend::close() {
+    if (m_handle) {
+        pcap_close(m_handle);
+        m_handle = nullptr;
+    }
+}
+
+bool PcapCaptureBackend::setFilter(const std::string& bpf_filter) {
+    if (!m_handle) return false;
+
+    struct bpf_program fp;
+    bpf_u_int32 net = 0;
+
+    if (pcap_compile(m_handle, &fp, bpf_filter.c_str(), 0, net) == -1) {
+        std::cerr << "[ERROR] Could not compile filter: " << pcap_geterr(m_handle) << std::endl;
+        return false;
+    }
+
+    if (pcap_setfilter(m_handle, &fp) == -1) {
+        std::cerr << "[ERROR] Could not set filter: " << pcap_geterr(m_handle) << std::endl;
+        pcap_freecode(&fp);
+        return false;
+    }
+
+    pcap_freecode(&fp);
+    return true;
+}
+
+int PcapCaptureBackend::dispatch(int max_packets, PacketHandler handler, u_char* user) {
+    if (!m_handle) return -1;
+
+    DispatchContext ctx{handler, user};
+    int result = pcap_dispatch(m_handle, max_packets, pcapTrampoline, reinterpret_cast<u_char*>(&ctx));
+    if (result == -1) {
+        std::cerr << "[ERROR] pcap_dispatch error: " << pcap_geterr(m_handle) << std::endl;
+    } else if (result == -2) {
+        result = 0;  // pcap_breakloop
+    }
+    return result;
+}
+
+int PcapCaptureBackend::getSelectableFd() const {
+    return m_handle ? pcap_get_selectable_fd(m_handle) : -1;
+}
+
+int PcapCaptureBackend::getDatalink() const {
+    return m_handle ? pcap_datalink(m_handle) : -1;
+}
+
+int PcapCaptureBackend::getTimestampPrecision() const {
+    return m_handle ? pcap_get_tstamp_precision(m_handle) : PCAP_TSTAMP_PRECISION_MICRO;
+}
+
+bool PcapCaptureBackend::getStats(CaptureStats& stats) {
+    if (!m_handle) return false;
+
+    struct pcap_stat ps;
+    if (pcap_stats(m_handle, &ps) == -1) {
+        return false;
+    }
+
+    stats.packets_received = ps.ps_recv;
+    stats.packets_dropped = static_cast<uint64_t>(ps.ps_drop) + ps.ps_ifdrop;
+    stats.ring_freezes = 0;
+    return true;
+}
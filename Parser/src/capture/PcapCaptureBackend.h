@@ -0,0 +1,30 @@
+#ifndef PCAP_CAPTURE_BACKEND_H
+#define PCAP_CAPTURE_BACKEND_H
+
+#include "ICaptureBackend.h"
+
+// libpcap 기반 캡처 백엔드 (기본값 / TPACKET_V3 실패 시 fallback)
+class PcapCaptureBackend : public ICaptureBackend {
+public:
+    explicit PcapCaptureBackend(const CaptureConfig& config);
+    ~PcapCaptureBackend() override;
+
+    std::string getName() const override { return "pcap"; }
+
+    bool open() override;
+    void close() override;
+    bool setFilter(const std::string& bpf_filter) override;
+
+    int dispatch(int max_packets, PacketHandler handler, u_char* user) override;
+
+    int getSelectableFd() const override;
+    int getDatalink() const override;
+    int getTimestampPrecision() const override;
+    bool getStats(CaptureStats& stats) override;
+
+private:
+    CaptureConfig m_config;
+    pcap_t* m_handle = nullptr;
+};
+
+#endif // PCAP_CAPTURE_BACKEND_H
@@ -0,0 +1,44 @@
+#include "ReplayPacer.h"
+
+ReplayPacer::ReplayPacer(double speed, double pps, bool nano_precision)
+    : m_speed(speed), m_pps(pps), m_nano(nano_precision) {}
+
+ReplayPacer::Clock::time_point ReplayPacer::due(const struct pcap_pkthdr& header) {
+    int64_t ts_ns = static_cast<int64_t>(header.ts.tv_sec) * 1000000000LL +
+                    static_cast<int64_t>(header.ts.tv_usec) * (m_nano ? 1 : 1000);
+
+    if (!m_started) {
+        m_started = true;
+        m_start = Clock::now();
+        m_first_ts_ns = ts_ns;
+    }
+
+    int64_t offset_ns;
+    if (m_pps > 0.0) {
+        offset_ns = static_cast<int64_t>(static_cast<double>(m_index) * 1e9 / m_pps);
+    } else {
+        // 시간이 역행하는 패킷은 바로 내보냄
+        int64_t delta = ts_ns - m_first_ts_ns;
+        offset_ns = delta > 0 ? static_cast<int64_t>(static_cast<double>(delta) / m_speed) : 0;
+    }
+    m_index++;
+
+    return m_start + std::chrono::nanoseconds(offset_ns);
+}
+
+void ReplayPacer::sent(Clock::time_point due_time, Clock::time_point now) {
+    m_sent++;
+    m_last_sent = now;
+    int64_t lag_us = std::chrono::duration_cast<std::chrono::microseconds>(now - due_time).count();
+    if (lag_us >= 1000) {
+        m_late++;
+    }
+    if (lag_us > m_max_lag_us) {
+        m_max_lag_us = lag_us;
+    }
+}
+
+double ReplayPacer::getElapsedSeconds() const {
+    if (m_sent == 0) return 0.0;
+    return std::chrono::duration<double>(m_last_sent - m_start).count();
+}
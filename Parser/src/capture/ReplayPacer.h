@@ -0,0 +1,47 @@
+#ifndef REPLAY_PACER_H
+#define REPLAY_PACER_H
+
+#include <pcap.h>
+#include <chrono>
+#include <cstdint>
+
+// 오프라인 패킷을 원래 capture 간격(배속) 또는 고정 pps로 내보내기 위한 스케줄 계산
+// realtime sink(ES/Redis)의 처리 여유와 드롭 동작을 측정할 때 사용합니다.
+class ReplayPacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // speed > 0: 원래 간격 / speed, pps > 0: 고정 속도 (pps가 우선), 둘 다 0이면 비활성
+    ReplayPacer(double speed, double pps, bool nano_precision);
+
+    bool isEnabled() const { return m_speed > 0.0 || m_pps > 0.0; }
+
+    // 다음 패킷을 내보내야 하는 시각 (첫 호출 시각이 기준)
+    Clock::time_point due(const struct pcap_pkthdr& header);
+
+    // 실제로 내보낸 시각을 기록 (지연 통계용)
+    void sent(Clock::time_point due_time, Clock::time_point now);
+
+    uint64_t getPacketsSent() const { return m_sent; }
+    uint64_t getPacketsLate() const { return m_late; }
+    double getMaxLagMs() const { return m_max_lag_us / 1000.0; }
+    // 첫 패킷부터 마지막으로 내보낸 패킷까지 걸린 시간
+    double getElapsedSeconds() const;
+
+private:
+    double m_speed;
+    double m_pps;
+    bool m_nano;
+
+    bool m_started = false;
+    Clock::time_point m_start;
+    int64_t m_first_ts_ns = 0;
+    uint64_t m_index = 0;
+
+    Clock::time_point m_last_sent;
+    uint64_t m_sent = 0;
+    uint64_t m_late = 0;          // 예정 시각보다 1 ms 이상 늦게 나간 패킷
+    int64_t m_max_lag_us = 0;
+};
+
+#endif // REPLAY_PACER_H
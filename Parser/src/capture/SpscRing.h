@@ -0,0 +1,104 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// lock-free single-producer/single-consumer ring
+// push()/steal()은 캡처 스레드 하나, pop()은 담당 worker 하나에서만 호출해야 합니다.
+template <typename T>
+class SpscRing {
+public:
+    SpscRing() : m_mask(0), m_head(0), m_tail(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // 용량은 2의 거듭제곱으로 올림
+    void init(size_t capacity) {
+        size_t slots = 1;
+        while (slots < capacity) slots <<= 1;
+        m_buffer.assign(slots, T());
+        m_mask = slots - 1;
+        m_head.store(0);
+        m_tail.store(0);
+    }
+
+    bool push(T value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_buffer.size()) {
+            return false;  // 가득 참
+        }
+        m_buffer[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 여러 항목을 tail 한 번 갱신으로 publish (전부 들어갈 공간이 없으면 false)
+    bool pushBatch(T* values, size_t count) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail + count - m_head.load(std::memory_order_acquire) > m_buffer.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            m_buffer[(tail + i) & m_mask] = std::move(values[i]);
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            return take(value);
+        }
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(m_buffer[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // producer가 가장 오래된 항목을 빼앗음 (drop-oldest용, 포인터 같은 trivially copyable 타입만)
+    // 이 경우 pop()도 head를 CAS로 옮기므로 consumer와 경쟁해도 항목이 중복되지 않음
+    bool steal(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "steal() needs a trivially copyable type");
+        return take(value);
+    }
+
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return m_buffer.size(); }
+
+private:
+    bool take(T& value) {
+        size_t head = m_head.load(std::memory_order_acquire);
+        while (head != m_tail.load(std::memory_order_acquire)) {
+            T candidate = m_buffer[head & m_mask];
+            if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel)) {
+                value = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<T> m_buffer;
+    size_t m_mask;
+
+    // producer/consumer 인덱스가 같은 캐시 라인을 공유하지 않도록 분리
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,405 @@
+#include "TpacketV3CaptureBackend.h"
+#include "CaptureEventLoop.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+#include <poll.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+
+TpacketV3CaptureBackend::TpacketV3CaptureBackend(const CaptureConfig& config)
+    : m_config(config) {}
+
+TpacketV3CaptureBackend::~TpacketV3CaptureBackend() {
+    close();
+}
+
+int TpacketV3CaptureBackend::datalinkForDevice(const std::string& interface) {
+    int probe = socket(AF_INET, SOCK_DGRAM, 0);
+    if (probe < 0) return -1;
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, interface.c_str(), sizeof(ifr.ifr_name) - 1);
+    int result = ioctl(probe, SIOCGIFHWADDR, &ifr);
+    ::close(probe);
+    if (result < 0) return -1;
+
+    switch (ifr.ifr_hwaddr.sa_family) {
+        case ARPHRD_ETHER:
+        case ARPHRD_LOOPBACK:   // lo도 zero MAC의 Ethernet 헤더가 붙음
+            return DLT_EN10MB;
+        default:
+            return -1;
+    }
+}
+
+bool TpacketV3CaptureBackend::open() {
+    // SOCK_RAW 프레임은 장치의 링크 헤더를 그대로 담으므로 Ethernet 장치만 받음
+    // "any"와 tun/ppp 같은 IP 전용 장치는 libpcap(cooked capture, BPF 오프셋 보정)으로 fallback
+    if (m_config.interface == "any") {
+        std::cerr << "[ERROR] TPACKET_V3 backend needs a single Ethernet interface, not \"any\"" << std::endl;
+        return false;
+    }
+    m_datalink = datalinkForDevice(m_config.interface);
+    if (m_datalink < 0) {
+        std::cerr << "[ERROR] TPACKET_V3 backend supports only Ethernet interfaces (" << m_config.interface
+                  << " is not one or does not exist)" << std::endl;
+        return false;
+    }
+
+    m_fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (m_fd < 0) {
+        std::cerr << "[ERROR] AF_PACKET socket failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    m_ifindex = static_cast<int>(if_nametoindex(m_config.interface.c_str()));
+    if (m_ifindex == 0) {
+        std::cerr << "[ERROR] Unknown interface " << m_config.interface << std::endl;
+        close();
+        return false;
+    }
+
+    if (m_config.buffer_size > 0) {
+        std::cout << "[PCAP] buffer_size is ignored by TPACKET_V3 (ring = block_size x block_count)" << std::endl;
+    }
+
+    m_release_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_release_fd < 0) {
+        std::cerr << "[ERROR] eventfd failed: " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    if (!setupRing()) {
+        close();
+        return false;
+    }
+
+    struct sockaddr_ll ll;
+    memset(&ll, 0, sizeof(ll));
+    ll.sll_family = AF_PACKET;
+    ll.sll_protocol = htons(ETH_P_ALL);
+    ll.sll_ifindex = m_ifindex;
+
+    if (bind(m_fd, reinterpret_cast<struct sockaddr*>(&ll), sizeof(ll)) < 0) {
+        std::cerr << "[ERROR] AF_PACKET bind to " << m_config.interface << " failed: "
+                  << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    if (m_config.promiscuous && !enablePromiscuous()) {
+        std::cerr << "[WARN] Could not enable promiscuous mode on " << m_config.interface << std::endl;
+    }
+
+    if (!m_config.fanout_mode.empty() && !joinFanoutGroup()) {
+        close();
+        return false;
+    }
+
+    std::cout << "[PCAP] Opened " << m_config.interface << " (TPACKET_V3 ring: "
+              << m_config.block_count << " x " << (m_config.block_size / 1024) << " KiB blocks, "
+              << "retire " << (m_config.immediate_mode ? 1 : m_config.retire_timeout_ms) << " ms, "
+              << "snaplen " << m_config.snaplen << ", "
+              << (m_config.nano_precision ? "ns" : "us") << " timestamps";
+    if (!m_config.fanout_mode.empty()) {
+        std::cout << ", fanout " << m_config.fanout_mode << " group " << m_config.fanout_group_id;
+    }
+    std::cout << ")" << std::endl;
+    return true;
+}
+
+bool TpacketV3CaptureBackend::joinFanoutGroup() {
+    int mode;
+    if (m_config.fanout_mode == "hash") {
+        // 커널 flow hash는 주소/포트를 정렬해서 계산하므로 요청/응답이 같은 소켓으로 감
+        mode = PACKET_FANOUT_HASH | PACKET_FANOUT_FLAG_DEFRAG;
+    } else if (m_config.fanout_mode == "cpu") {
+        mode = PACKET_FANOUT_CPU;
+    } else if (m_config.fanout_mode == "lb") {
+        mode = PACKET_FANOUT_LB;
+    } else if (m_config.fanout_mode == "qm") {
+        mode = PACKET_FANOUT_QM;
+    } else {
+        std::cerr << "[ERROR] Unknown fanout mode: " << m_config.fanout_mode << std::endl;
+        return false;
+    }
+
+    int fanout_arg = (m_config.fanout_group_id & 0xffff) | (mode << 16);
+    if (setsockopt(m_fd, SOL_PACKET, PACKET_FANOUT, &fanout_arg, sizeof(fanout_arg)) < 0) {
+        std::cerr << "[ERROR] PACKET_FANOUT (group " << m_config.fanout_group_id << ") failed: "
+                  << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TpacketV3CaptureBackend::setupRing() {
+    int version = TPACKET_V3;
+    if (setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+        std::cerr << "[ERROR] PACKET_VERSION(TPACKET_V3) failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // 태그 하나(4바이트)만큼 MAC 헤더 앞에 여유를 둠 (libpcap과 같은 방식, ring 생성 전에 설정해야 함)
+    unsigned int reserve = 4;
+    m_vlan_reserve = setsockopt(m_fd, SOL_PACKET, PACKET_RESERVE, &reserve, sizeof(reserve)) == 0;
+    if (!m_vlan_reserve) {
+        std::cerr << "[WARN] PACKET_RESERVE failed, offloaded VLAN tags will be lost: " << strerror(errno) << std::endl;
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (m_config.block_size <= 0 || m_config.block_size % page_size != 0 || m_config.block_count <= 0) {
+        std::cerr << "[ERROR] Invalid TPACKET_V3 ring: block_size must be a multiple of "
+                  << page_size << " and block_count > 0" << std::endl;
+        return false;
+    }
+
+    // V3는 가변 길이 프레임이지만 커널이 frame_size/frame_nr 정합성을 검사함
+    const unsigned int frame_size = TPACKET_ALIGNMENT << 7;  // 2048
+    struct tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = static_cast<unsigned int>(m_config.block_size);
+    req.tp_block_nr = static_cast<unsigned int>(m_config.block_count);
+    req.tp_frame_size = frame_size;
+    req.tp_frame_nr = (req.tp_block_size / frame_size) * req.tp_block_nr;
+    // immediate 모드에서는 블록이 차기를 기다리지 않도록 최소 retire 시간 사용
+    req.tp_retire_blk_tov = static_cast<unsigned int>(m_config.immediate_mode ? 1 : m_config.retire_timeout_ms);
+    req.tp_feature_req_word = 0;
+
+    if (setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+        std::cerr << "[ERROR] PACKET_RX_RING failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    m_ring_size = static_cast<size_t>(req.tp_block_size) * req.tp_block_nr;
+    void* ring = mmap(nullptr, m_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (ring == MAP_FAILED) {
+        std::cerr << "[ERROR] TPACKET_V3 ring mmap failed: " << strerror(errno) << std::endl;
+        m_ring_size = 0;
+        return false;
+    }
+    m_ring = static_cast<uint8_t*>(ring);
+
+    m_blocks.resize(req.tp_block_nr);
+    m_leases.reset(new BlockLease[req.tp_block_nr]);
+    for (unsigned int i = 0; i < req.tp_block_nr; ++i) {
+        m_blocks[i] = reinterpret_cast<tpacket_block_desc*>(m_ring + static_cast<size_t>(i) * req.tp_block_size);
+        m_leases[i].block = m_blocks[i];
+        m_leases[i].release_fd = m_release_fd;
+    }
+    m_current_block = 0;
+    return true;
+}
+
+bool TpacketV3CaptureBackend::enablePromiscuous() {
+    struct packet_mreq mreq;
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = m_ifindex;
+    mreq.mr_type = PACKET_MR_PROMISC;
+    return setsockopt(m_fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) == 0;
+}
+
+void TpacketV3CaptureBackend::BlockLease::release() {
+    // 마지막 참조가 해제되면 블록을 커널에 반환
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        in_flight.store(false, std::memory_order_release);
+
+        // 블록 단위라 드묾: lease 반환을 기다리는 캡처 스레드를 깨움
+        uint64_t one = 1;
+        ssize_t written = write(release_fd, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void TpacketV3CaptureBackend::close() {
+    // 호출자는 close() 전에 모든 lease가 release되었음을 보장해야 함
+    if (m_ring) {
+        munmap(m_ring, m_ring_size);
+        m_ring = nullptr;
+        m_ring_size = 0;
+    }
+    m_blocks.clear();
+    m_leases.reset();
+    m_lease_stalled = false;
+
+    if (m_release_fd >= 0) {
+        ::close(m_release_fd);
+        m_release_fd = -1;
+    }
+
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool TpacketV3CaptureBackend::setFilter(const std::string& bpf_filter) {
+    if (m_fd < 0) return false;
+
+    // libpcap으로 classic BPF를 컴파일한 뒤 소켓에 직접 attach
+    pcap_t* dead = pcap_open_dead(m_datalink, m_config.snaplen);
+    if (!dead) {
+        std::cerr << "[ERROR] pcap_open_dead failed" << std::endl;
+        return false;
+    }
+
+    struct bpf_program fp;
+    if (pcap_compile(dead, &fp, bpf_filter.c_str(), 1, PCAP_NETMASK_UNKNOWN) == -1) {
+        std::cerr << "[ERROR] Could not compile filter: " << pcap_geterr(dead) << std::endl;
+        pcap_close(dead);
+        return false;
+    }
+
+    struct sock_fprog prog;
+    prog.len = static_cast<unsigned short>(fp.bf_len);
+    prog.filter = reinterpret_cast<struct sock_filter*>(fp.bf_insns);
+
+    bool ok = setsockopt(m_fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == 0;
+    if (!ok) {
+        std::cerr << "[ERROR] Could not set filter: " << strerror(errno) << std::endl;
+    }
+
+    pcap_freecode(&fp);
+    pcap_close(dead);
+    return ok;
+}
+
+const u_char* TpacketV3CaptureBackend::restoreVlanTag(const tpacket3_hdr* frame, struct pcap_pkthdr& header) const {
+    uint8_t* mac = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(frame)) + frame->tp_mac;
+    if (!m_vlan_reserve || header.caplen < 12 || frame->tp_mac < TPACKET3_HDRLEN + 4) {
+        return mac;
+    }
+
+    // dst/src MAC 12바이트만 4바이트 앞으로 당기고 그 자리에 TPID + TCI 기록 (ring 메모리 안에서 처리)
+    uint8_t* tagged = mac - 4;
+    memmove(tagged, mac, 12);
+    uint16_t tpid = (frame->tp_status & TP_STATUS_VLAN_TPID_VALID) ? frame->hv1.tp_vlan_tpid : ETH_P_8021Q;
+    uint16_t tag[2] = {htons(tpid), htons(static_cast<uint16_t>(frame->hv1.tp_vlan_tci))};
+    memcpy(tagged + 12, tag, sizeof(tag));
+
+    header.caplen += 4;
+    header.len += 4;
+    return tagged;
+}
+
+int TpacketV3CaptureBackend::dispatch(int max_packets, PacketHandler handler, u_char* user) {
+    if (m_fd < 0 || m_blocks.empty()) return -1;
+
+    int count = 0;
+    const bpf_u_int32 snaplen = static_cast<bpf_u_int32>(m_config.snaplen);
+
+    // 블록 단위로 처리하므로 max_packets는 블록 경계에서만 확인
+    while (max_packets <= 0 || count < max_packets) {
+        tpacket_block_desc* block = m_blocks[m_current_block];
+        BlockLease& lease = m_leases[m_current_block];
+
+        // 아직 worker가 붙잡고 있는 블록 (커널이 다시 채우지 않았고 status도 USER 그대로)
+        // ring이 가득 찬 상태라 소켓은 계속 readable이므로 epoll로 돌아가면 busy loop가 됨
+        // 처음에는 0을 반환해서 호출한 쪽이 모아 둔 배치(lease 포함)를 넘기게 하고,
+        // 그 다음 호출부터는 lease 반환 eventfd에서 대기
+        if (lease.in_flight.load(std::memory_order_acquire)) {
+            if (count > 0 || !m_lease_stalled) {
+                m_lease_stalled = count == 0;
+                break;
+            }
+            if (!waitForRelease(lease)) break;
+        }
+        m_lease_stalled = false;
+
+        // 반환한 블록은 커널이 다시 채워야 USER가 됨
+        if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+            break;
+        }
+
+        uint32_t num_pkts = block->hdr.bh1.num_pkts;
+
+        // 프레임마다 1 + 블록 순회가 끝날 때까지 dispatch 자신이 1
+        lease.in_flight.store(true, std::memory_order_relaxed);
+        lease.refs.store(num_pkts + 1, std::memory_order_release);
+        const uint8_t* base = reinterpret_cast<const uint8_t*>(block);
+        const tpacket3_hdr* frame = reinterpret_cast<const tpacket3_hdr*>(base + block->hdr.bh1.offset_to_first_pkt);
+
+        for (uint32_t i = 0; i < num_pkts; ++i) {
+            struct pcap_pkthdr header;
+            header.ts.tv_sec = frame->tp_sec;
+            header.ts.tv_usec = m_config.nano_precision ? frame->tp_nsec : frame->tp_nsec / 1000;
+            header.caplen = frame->tp_snaplen < snaplen ? frame->tp_snaplen : snaplen;
+            header.len = frame->tp_len;
+
+            // handler가 프레임을 넘긴 뒤 release할 수 있으므로 다음 오프셋을 먼저 읽음
+            const uint8_t* next = reinterpret_cast<const uint8_t*>(frame) + frame->tp_next_offset;
+
+            // ring 블록 메모리를 그대로 전달 (복사 없음)
+            const u_char* data = reinterpret_cast<const u_char*>(frame) + frame->tp_mac;
+            if (frame->tp_status & TP_STATUS_VLAN_VALID) {
+                data = restoreVlanTag(frame, header);
+            }
+            handler(user, &header, data, &lease);
+
+            frame = reinterpret_cast<const tpacket3_hdr*>(next);
+        }
+
+        count += static_cast<int>(num_pkts);
+
+        lease.release();
+        m_current_block = (m_current_block + 1) % m_blocks.size();
+    }
+
+    return count;
+}
+
+bool TpacketV3CaptureBackend::waitForRelease(const BlockLease& lease) {
+    struct pollfd fds[2];
+    fds[0].fd = m_release_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = CaptureEventLoop::shutdownFd();
+    fds[1].events = POLLIN;
+    nfds_t nfds = fds[1].fd >= 0 ? 2 : 1;
+
+    while (lease.in_flight.load(std::memory_order_acquire)) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        int n = poll(fds, nfds, m_config.poll_timeout_ms > 0 ? m_config.poll_timeout_ms : -1);
+        if (n < 0 && errno != EINTR) return false;
+        // timeout(주기 작업) 또는 종료 요청이면 0을 반환하도록 호출한 쪽으로 돌아감
+        if (n == 0 || (nfds == 2 && (fds[1].revents & POLLIN))) return false;
+
+        if (fds[0].revents & POLLIN) {
+            uint64_t value;
+            ssize_t got = read(m_release_fd, &value, sizeof(value));
+            (void)got;
+        }
+    }
+    return true;
+}
+
+bool TpacketV3CaptureBackend::getStats(CaptureStats& stats) {
+    if (m_fd < 0) return false;
+
+    // PACKET_STATISTICS는 읽을 때마다 0으로 리셋되므로 누적
+    struct tpacket_stats_v3 st;
+    socklen_t len = sizeof(st);
+    if (getsockopt(m_fd, SOL_PACKET, PACKET_STATISTICS, &st, &len) < 0) {
+        return false;
+    }
+
+    m_stats.packets_received += st.tp_packets;
+    m_stats.packets_dropped += st.tp_drops;
+    m_stats.ring_freezes += st.tp_freeze_q_cnt;
+    stats = m_stats;
+    return true;
+}
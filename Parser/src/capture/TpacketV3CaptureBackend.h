@@ -0,0 +1,74 @@
+#ifndef TPACKET_V3_CAPTURE_BACKEND_H
+#define TPACKET_V3_CAPTURE_BACKEND_H
+
+#include "ICaptureBackend.h"
+#include <vector>
+#include <atomic>
+#include <memory>
+
+struct tpacket_block_desc;
+struct tpacket3_hdr;
+
+// AF_PACKET TPACKET_V3 mmap block ring 캡처 백엔드 (Linux 전용)
+// 커널이 채운 블록의 프레임을 복사 없이 handler에 전달하고, 블록의 모든 프레임이
+// release된 뒤에 블록을 커널에 반환합니다. (worker가 ring 메모리를 직접 읽음)
+class TpacketV3CaptureBackend : public ICaptureBackend {
+public:
+    explicit TpacketV3CaptureBackend(const CaptureConfig& config);
+    ~TpacketV3CaptureBackend() override;
+
+    std::string getName() const override { return "tpacket_v3"; }
+
+    bool open() override;
+    void close() override;
+    bool setFilter(const std::string& bpf_filter) override;
+
+    int dispatch(int max_packets, PacketHandler handler, u_char* user) override;
+
+    int getSelectableFd() const override { return m_fd; }
+    int getDatalink() const override { return m_datalink; }
+    int getTimestampPrecision() const override {
+        return m_config.nano_precision ? PCAP_TSTAMP_PRECISION_NANO : PCAP_TSTAMP_PRECISION_MICRO;
+    }
+    bool getStats(CaptureStats& stats) override;
+
+private:
+    // 블록 하나를 모든 프레임 처리가 끝날 때까지 유지하는 lease
+    class BlockLease : public PacketLease {
+    public:
+        void release() override;
+
+        tpacket_block_desc* block = nullptr;
+        int release_fd = -1;                  // 블록이 반환될 때 캡처 스레드를 깨우는 eventfd
+        std::atomic<uint32_t> refs{0};
+        std::atomic<bool> in_flight{false};   // 커널 반환(status 기록)까지 끝나야 false
+    };
+
+    CaptureConfig m_config;
+    int m_fd = -1;
+    int m_ifindex = 0;
+    int m_datalink = DLT_EN10MB;
+
+    uint8_t* m_ring = nullptr;
+    size_t m_ring_size = 0;
+    std::vector<tpacket_block_desc*> m_blocks;
+    std::unique_ptr<BlockLease[]> m_leases;
+    size_t m_current_block = 0;
+    int m_release_fd = -1;
+    bool m_lease_stalled = false;  // 다음 블록이 lease 중이라 직전 dispatch가 0을 반환함
+    bool m_vlan_reserve = false;   // PACKET_RESERVE 성공 (떼어낸 VLAN 태그를 다시 넣을 공간 있음)
+
+    CaptureStats m_stats;
+
+    // 장치의 ARPHRD_* 타입을 DLT로 변환 (SOCK_RAW로 Ethernet 프레임을 받는 장치만 지원, 아니면 -1)
+    static int datalinkForDevice(const std::string& interface);
+    bool setupRing();
+    // 다음 블록을 붙잡은 lease가 반환되거나 종료 요청/timeout까지 대기 (반환되었으면 true)
+    bool waitForRelease(const BlockLease& lease);
+    // 커널(NIC offload)이 떼어낸 VLAN 태그를 프레임 앞 reserve 공간에 다시 끼워 넣음
+    const u_char* restoreVlanTag(const tpacket3_hdr* frame, struct pcap_pkthdr& header) const;
+    bool enablePromiscuous();
+    bool joinFanoutGroup();
+};
+
+#endif // TPACKET_V3_CAPTURE_BACKEND_H
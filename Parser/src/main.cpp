@@ -4,11 +4,21 @@
 #include <cstring>
 #include <getopt.h>
 #include <chrono>
+#include <algorithm>
 #include <thread>
 #include <pcap.h>
+#include <unistd.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
 #include "PacketParser.h"
+#include "ThreadPlacement.h"
+#include "CpuBudget.h"
 #include "RedisCache.h"
 #include "ElasticsearchClient.h"
+#include "capture/ICaptureBackend.h"
+#include "capture/CaptureEventLoop.h"
+#include "capture/OfflineMergeReader.h"
+#include "capture/ReplayPacer.h"
 
 // ============================================================================
 // Global Variables
@@ -22,6 +32,7 @@ static PacketParser* g_parser = nullptr;
 void signalHandler(int signal) {
     std::cout << "\n[Main] Received signal " << signal << ", shutting down..." << std::endl;
     g_running = false;
+    CaptureEventLoop::requestShutdown();
 }
 
 // ============================================================================
@@ -44,16 +55,83 @@ bool getEnvBool(const char* name, bool default_value = false) {
     return (str == "true" || str == "1" || str == "yes");
 }
 
+// "a,b, c" -> {"a", "b", "c"}
+std::vector<std::string> splitList(const std::string& value, char delimiter = ',') {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= value.size()) {
+        size_t end = value.find(delimiter, start);
+        if (end == std::string::npos) end = value.size();
+
+        std::string item = value.substr(start, end - start);
+        size_t first = item.find_first_not_of(" \t");
+        size_t last = item.find_last_not_of(" \t");
+        if (first != std::string::npos) {
+            items.push_back(item.substr(first, last - first + 1));
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
 void printUsage(const char* program) {
     std::cout << "\nUsage: " << program << " [options]\n\n"
               << "Options:\n"
               << "  -i, --interface <name>    Network interface to capture (default: any)\n"
-              << "  -p, --pcap <file>         PCAP file to read (offline mode)\n"
+              << "  -p, --pcap <path>         PCAP/pcapng file, glob or directory (offline mode, repeatable;\n"
+              << "                            extra arguments are also read, merged by timestamp)\n"
               << "  -f, --filter <bpf>        BPF filter string\n"
               << "  -o, --output <dir>        Output directory (default: /data/output)\n"
               << "  -r, --rolling <minutes>   File rolling interval in minutes (0 = no rolling)\n"
               << "  --realtime                Realtime mode (no file output, only ES/Redis)\n"
-              << "  --threads <num>           Number of worker threads (0 = auto)\n"
+              << "  --threads <num>           Number of worker threads (0 = auto from cgroup CPU budget)\n"
+              << "  --inline                  Run-to-completion: parse on the capture thread (no queue, 1 thread)\n"
+              << "  --capture-backend <name>  Live capture backend: pcap | tpacket_v3 (Ethernet interface\n"
+              << "                            only, default: pcap)\n"
+              << "  --tpacket-block-size <n>  TPACKET_V3 block size in bytes (default: 4194304)\n"
+              << "  --tpacket-block-count <n> TPACKET_V3 number of blocks (default: 64)\n"
+              << "  --tpacket-retire-ms <ms>  TPACKET_V3 block retire timeout (default: 60)\n"
+              << "  --fanout <mode>           PACKET_FANOUT mode: hash | cpu | lb | qm (one TPACKET_V3\n"
+              << "                            socket per worker, ring size applies per socket;\n"
+              << "                            only hash keeps a flow on one worker, cpu/lb/qm break\n"
+              << "                            request/response matching and reassembly)\n"
+              << "  --fanout-group <id>       PACKET_FANOUT group id (0 = derive from pid)\n"
+              << "  --poll-timeout <ms>       Max epoll wait when idle (default: 1000)\n"
+              << "  --snaplen <bytes>         Capture snapshot length (default: 65535)\n"
+              << "  --buffer-size <bytes>     Kernel capture buffer size (default: libpcap default)\n"
+              << "  --immediate               Deliver packets immediately (no kernel buffering)\n"
+              << "  --no-promisc              Disable promiscuous mode\n"
+              << "  --tstamp-precision <p>    Timestamp precision: micro | nano (default: micro)\n"
+              << "  --config <file>           config.json with parser.* capture settings\n"
+              << "  --offline-reader <name>   PCAP file reader: mmap | pcap (default: mmap)\n"
+              << "  --offline-chunk <n>       Packets per worker chunk in mmap reader (default: 4096)\n"
+              << "  --replay-speed <x>        Replay PCAP input at x times original speed (1 = real time)\n"
+              << "  --replay-pps <n>          Replay PCAP input at a fixed packets/sec rate\n"
+              << "  --auto-filter             Build the BPF filter from the enabled protocol parsers\n"
+              << "  --auto-filter-protocols <list>\n"
+              << "                            Comma-separated parser names for --auto-filter\n"
+              << "                            (e.g. modbus,s7comm,arp; implies --auto-filter)\n"
+              << "  --auto-filter-keep-tcp    Keep all TCP for tcp_session records in --auto-filter\n"
+              << "  --pool-slots <n>          Preallocated packet slots = max queued packets (default: 8192)\n"
+              << "  --pool-slot-size <bytes>  Bytes per packet slot (default: min(snaplen, 2048))\n"
+              << "  --hugepages               Back the packet pool with hugepages (MAP_HUGETLB)\n"
+              << "  --cpu <role>=<cpus>       Pin a thread role to CPUs (repeatable; roles: capture, workers,\n"
+              << "                            flush, es, redis, pipeline; e.g. --cpu capture=0 --cpu workers=2-5)\n"
+              << "  --overload-policy <p>     Full queue: block | drop_newest | drop_oldest | shed_low_priority\n"
+              << "                            (default: block for PCAP input, drop_newest for live capture)\n"
+              << "  --queue-max-bytes <bytes> Also bound the queue by captured bytes (default: 0 = slots only)\n"
+              << "  --handoff-batch <n>       Packets handed to a worker at once (default: 32, 1 = per packet)\n"
+              << "  --handoff-timeout-us <us> Max time a partial batch waits before handoff (default: 200)\n"
+              << "  --pipeline <spec>         Threads per record stage after decode, e.g. enrich=1,serialize=2,sink=1\n"
+              << "                            (0 = run on the previous stage's thread; default from CPU budget)\n"
+              << "  --pipeline-batch <n>      Records per batch between stages (default: 64)\n"
+              << "  --pipeline-queue <n>      Batches queued in front of each stage (default: 32)\n"
+              << "  --frag-max-bytes <bytes>  Memory cap for IPv4 fragments awaiting reassembly (default: 4194304)\n"
+              << "  --frag-timeout <sec>      Drop incomplete IPv4 fragment sets after this long (default: 30)\n"
+              << "  --tcp-stream-max-bytes <bytes>\n"
+              << "                            Memory cap for Modbus/S7/XGT TCP stream reassembly (default: 8388608,\n"
+              << "                            0 = parse each segment on its own)\n"
+              << "  --tcp-stream-timeout <sec> Drop idle TCP stream buffers after this long (default: 120)\n"
               << "  -h, --help                Show this help message\n\n"
               << "Environment Variables:\n"
               << "  NETWORK_INTERFACE         Network interface (default: any)\n"
@@ -62,6 +140,43 @@ void printUsage(const char* program) {
               << "  ROLLING_INTERVAL          Rolling interval in minutes\n"
               << "  PARSER_MODE               'realtime' or 'with-files'\n"
               << "  PARSER_THREADS            Number of worker threads\n"
+              << "  INLINE_PARSING            Parse on the capture thread (true/false)\n"
+              << "  CAPTURE_BACKEND           Live capture backend (pcap | tpacket_v3)\n"
+              << "  TPACKET_BLOCK_SIZE        TPACKET_V3 block size in bytes\n"
+              << "  TPACKET_BLOCK_COUNT       TPACKET_V3 number of blocks\n"
+              << "  TPACKET_RETIRE_TIMEOUT_MS TPACKET_V3 block retire timeout in ms\n"
+              << "  FANOUT_MODE               PACKET_FANOUT mode (empty = single capture socket,\n"
+              << "                            use hash to keep flows on one worker)\n"
+              << "  FANOUT_GROUP_ID           PACKET_FANOUT group id\n"
+              << "  CAPTURE_POLL_TIMEOUT_MS   Max epoll wait when idle in ms\n"
+              << "  PCAP_SNAPLEN              Capture snapshot length\n"
+              << "  PCAP_BUFFER_SIZE          Kernel capture buffer size in bytes\n"
+              << "  PCAP_IMMEDIATE            Immediate mode (true/false)\n"
+              << "  PCAP_PROMISC              Promiscuous mode (true/false, default: true)\n"
+              << "  PCAP_TSTAMP_PRECISION     Timestamp precision (micro | nano)\n"
+              << "  PARSER_CONFIG             config.json path (parser.* capture settings)\n"
+              << "  OFFLINE_READER            PCAP file reader (mmap | pcap)\n"
+              << "  OFFLINE_CHUNK_PACKETS     Packets per worker chunk in mmap reader\n"
+              << "  REPLAY_SPEED              Replay speed multiplier for PCAP input (0 = as fast as possible)\n"
+              << "  REPLAY_PPS                Fixed replay rate in packets/sec for PCAP input\n"
+              << "  AUTO_BPF_FILTER           Build the BPF filter from the parsers (true/false)\n"
+              << "  AUTO_BPF_PROTOCOLS        Comma-separated parser allow-list for the auto filter\n"
+              << "  AUTO_BPF_KEEP_TCP_SESSION Keep all TCP in the auto filter (true/false)\n"
+              << "  PACKET_POOL_SLOTS         Preallocated packet slots\n"
+              << "  PACKET_POOL_SLOT_SIZE     Bytes per packet slot (0 = min(snaplen, 2048))\n"
+              << "  PACKET_POOL_HUGEPAGES     Back the packet pool with hugepages (true/false)\n"
+              << "  CPU_AFFINITY              Thread placement, e.g. \"capture=0;workers=2-5;es=1;redis=1\"\n"
+              << "  OVERLOAD_POLICY           Full queue policy (block | drop_newest | drop_oldest | shed_low_priority)\n"
+              << "  QUEUE_MAX_BYTES           Queue bound in captured bytes (0 = slots only)\n"
+              << "  HANDOFF_BATCH             Packets handed to a worker at once\n"
+              << "  HANDOFF_TIMEOUT_US        Max wait of a partial batch in microseconds\n"
+              << "  PIPELINE_STAGES           Threads per record stage, e.g. \"enrich=1,serialize=2,sink=1\"\n"
+              << "  PIPELINE_BATCH            Records per batch between stages\n"
+              << "  PIPELINE_QUEUE_BATCHES    Batches queued in front of each stage\n"
+              << "  IP_FRAG_MAX_BYTES         Memory cap for IPv4 fragment reassembly in bytes\n"
+              << "  IP_FRAG_TIMEOUT_SEC       IPv4 fragment reassembly timeout in seconds\n"
+              << "  TCP_STREAM_MAX_BYTES      Memory cap for TCP stream reassembly in bytes (0 = off)\n"
+              << "  TCP_STREAM_TIMEOUT_SEC    Idle timeout of TCP stream buffers in seconds\n"
               << "\n"
               << "  ELASTICSEARCH_HOST        Elasticsearch host (default: localhost)\n"
               << "  ELASTICSEARCH_PORT        Elasticsearch port (default: 9200)\n"
@@ -77,20 +192,223 @@ void printUsage(const char* program) {
               << "  REDIS_PASSWORD            Redis password\n"
               << "  REDIS_DB                  Redis database number (default: 0)\n"
               << "  REDIS_POOL_SIZE           Connection pool size (default: 8)\n"
-              << "  REDIS_ASYNC_WRITERS       Number of async writers (default: 2)\n"
+              << "  REDIS_ASYNC_WRITERS       Number of async writers (0 = from CPU budget)\n"
               << "  REDIS_ASYNC_QUEUE_SIZE    Async queue size (default: 10000)\n"
               << "  REDIS_TIMEOUT_MS          Timeout in ms (default: 1000)\n"
               << std::endl;
 }
 
+// 과부하 드롭을 사유별로, 분류별 내역과 함께 출력 (드롭이 없으면 생략)
+void printOverloadStats(const OverloadStats& stats) {
+    if (stats.totalDrops() == 0 && stats.blocked == 0) return;
+
+    std::cout << "[Stats] Overload: dropped=" << stats.totalDrops();
+    for (int reason = 0; reason < DROP_REASON_COUNT; ++reason) {
+        uint64_t reason_total = 0;
+        for (uint64_t count : stats.drops[reason]) reason_total += count;
+        if (reason_total == 0) continue;
+
+        std::cout << ", " << dropReasonName(reason) << "=" << reason_total << " (";
+        bool first = true;
+        for (int cls = 0; cls < TRAFFIC_CLASS_COUNT; ++cls) {
+            if (stats.drops[reason][cls] == 0) continue;
+            std::cout << (first ? "" : " ") << trafficClassName(cls) << "=" << stats.drops[reason][cls];
+            first = false;
+        }
+        std::cout << ")";
+    }
+    if (stats.blocked > 0) {
+        std::cout << ", capture_blocked=" << stats.blocked;
+    }
+    std::cout << std::endl;
+}
+
+// 단계별 처리량 (rate는 그 단계가 실제로 일한 시간 기준)
+void printPipelineStats(const RecordPipeline& pipeline) {
+    std::cout << "[Stats] Pipeline: decoded_records=" << pipeline.getEmittedRecords() << std::endl;
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        StageStats stats = pipeline.getStageStats(stage);
+        uint64_t rate = stats.busy_ns > 0 ? static_cast<uint64_t>(stats.records * 1e9 / stats.busy_ns) : 0;
+        std::cout << "  " << pipelineStageName(stage) << " ("
+                  << (stats.threads > 0 ? std::to_string(stats.threads) + " threads" : std::string("inline")) << "): "
+                  << "records=" << stats.records << ", batches=" << stats.batches
+                  << ", busy=" << stats.busy_ns / 1000000 << " ms, rate=" << rate << " rec/s";
+        if (stats.threads > 0) {
+            std::cout << ", queue_max=" << stats.max_depth << ", producer_waits=" << stats.producer_waits;
+        }
+        std::cout << std::endl;
+    }
+}
+
+// IPv4 조각 재조립 (조각이 없었으면 생략)
+void printReassemblyStats(const ReassemblyStats& stats) {
+    if (stats.fragments == 0 && stats.invalid == 0) return;
+
+    std::cout << "[Stats] IPv4 reassembly: fragments=" << stats.fragments
+              << ", completed=" << stats.completed << ", timed_out=" << stats.timed_out
+              << ", evicted_memory=" << stats.evicted_memory << ", invalid=" << stats.invalid
+              << ", in_use=" << stats.bytes_in_use << " bytes" << std::endl;
+}
+
+// Modbus/S7/XGT TCP stream 재조립 (stream으로 처리한 segment가 없었으면 생략)
+void printTcpStreamStats(const TcpStreamStats& stats) {
+    if (stats.segments == 0) return;
+
+    std::cout << "[Stats] TCP streams: segments=" << stats.segments << ", pdus=" << stats.pdus
+              << " (spanning_segments=" << stats.buffered_pdus << "), retransmissions=" << stats.retransmissions
+              << ", overlaps=" << stats.overlaps << ", out_of_order=" << stats.out_of_order
+              << ", gaps=" << stats.gaps << ", framing_errors=" << stats.framing_errors
+              << ", evicted=" << stats.evicted << ", streams=" << stats.streams
+              << ", in_use=" << stats.bytes_in_use << " bytes" << std::endl;
+}
+
+void printHandoffStats(const HandoffStats& stats) {
+    std::cout << "[Stats] Handoff: batches=" << stats.batches
+              << ", avg_batch=" << (stats.batches > 0 ? stats.packets / stats.batches : 0)
+              << " (full=" << stats.full_batches << ", timeout=" << stats.timeout_batches
+              << ", flush=" << stats.flush_batches << "), worker_wakeups=" << stats.doorbells << std::endl;
+}
+
 // ============================================================================
 // Packet Callback
 // ============================================================================
-void packetCallback(u_char* user, const struct pcap_pkthdr* header, const u_char* packet) {
-    if (!g_running) return;
+void packetCallback(u_char* user, const struct pcap_pkthdr* header, const u_char* packet, PacketLease* lease) {
+    if (!g_running) {
+        if (lease) lease->release();
+        return;
+    }
 
     PacketParser* parser = reinterpret_cast<PacketParser*>(user);
-    parser->parse(header, packet);
+    parser->parse(header, packet, lease);
+}
+
+// PCAP 파일 모드 (pcap_loop) 콜백
+void pcapFileCallback(u_char* user, const struct pcap_pkthdr* header, const u_char* packet) {
+    packetCallback(user, header, packet, nullptr);
+}
+
+// PACKET_FANOUT 그룹에 worker 수만큼 TPACKET_V3 소켓을 열어 worker에 하나씩 연결
+bool attachFanoutBackends(PacketParser* parser, CaptureConfig config, const std::string& bpf_filter) {
+    config.backend = "tpacket_v3";
+    if (config.fanout_group_id == 0) {
+        config.fanout_group_id = static_cast<int>(getpid() & 0xffff);
+    }
+
+    // lb는 round-robin, cpu/qm은 RSS 큐(보통 양방향 비대칭)를 따르고 조각 재조립(DEFRAG)도 없음
+    // -> 한 flow가 여러 worker로 나뉘어 worker별 flow 상태가 맞지 않음
+    bool splits_flows = config.fanout_mode == "cpu" || config.fanout_mode == "lb" || config.fanout_mode == "qm";
+    if (splits_flows && parser->getNumThreads() > 1) {
+        std::cerr << "[WARN] Fanout mode '" << config.fanout_mode << "' does not keep a flow on one worker: "
+                  << "Modbus/S7 request/response matching, TCP stream and IPv4 fragment reassembly "
+                  << "will be unreliable (use 'hash')" << std::endl;
+    }
+
+    std::cout << "[PCAP] Opening " << parser->getNumThreads() << " fanout sockets on "
+              << config.interface << " (mode: " << config.fanout_mode
+              << ", group: " << config.fanout_group_id << ")" << std::endl;
+
+    std::vector<std::unique_ptr<ICaptureBackend>> backends;
+    for (int i = 0; i < parser->getNumThreads(); ++i) {
+        auto backend = createCaptureBackend(config);
+        if (!backend->open()) {
+            return false;
+        }
+        if (!bpf_filter.empty() && !backend->setFilter(bpf_filter)) {
+            return false;
+        }
+        backends.push_back(std::move(backend));
+    }
+
+    parser->attachWorkerBackends(std::move(backends), config.poll_timeout_ms);
+    return true;
+}
+
+// replay 모드: 예정 시각이 된 패킷끼리 묶어서 worker에 넘기고, 다음 패킷 시각까지 대기
+void replayOfflinePackets(OfflineMergeReader& reader, ReplayPacer& pacer, size_t chunk_packets) {
+    typedef ReplayPacer::Clock Clock;
+
+    OfflineChunk chunk;
+    auto batch = std::make_shared<OfflineChunk>();
+    auto last_report = Clock::now();
+
+    auto flush = [&]() {
+        if (batch->empty()) return;
+        g_parser->parseChunk(std::move(batch));
+        batch = std::make_shared<OfflineChunk>();
+    };
+
+    while (g_running && reader.nextChunk(chunk, chunk_packets)) {
+        for (const OfflinePacket& packet : chunk) {
+            Clock::time_point due = pacer.due(packet.header);
+            Clock::time_point now = Clock::now();
+
+            if (due > now) {
+                flush();
+                // 종료 신호를 놓치지 않도록 최대 100 ms씩 대기
+                while (g_running && due > (now = Clock::now())) {
+                    std::this_thread::sleep_for(std::min<Clock::duration>(due - now, std::chrono::milliseconds(100)));
+                }
+                if (!g_running) return;
+            }
+
+            batch->push_back(packet);
+            pacer.sent(due, now);
+            if (batch->size() >= chunk_packets) {
+                flush();
+            }
+        }
+
+        auto now = Clock::now();
+        if (std::chrono::duration_cast<std::chrono::seconds>(now - last_report).count() >= 10) {
+            double elapsed = pacer.getElapsedSeconds();
+            std::cout << "[Replay] sent=" << pacer.getPacketsSent()
+                      << ", rate=" << static_cast<uint64_t>(elapsed > 0 ? pacer.getPacketsSent() / elapsed : 0) << " pps"
+                      << ", late=" << pacer.getPacketsLate()
+                      << ", max_lag=" << pacer.getMaxLagMs() << " ms" << std::endl;
+            last_report = now;
+        }
+    }
+    flush();
+}
+
+// config.json의 parser.* 캡처 설정을 기본값으로 적용 (환경 변수/커맨드 라인이 우선)
+bool loadParserConfig(const std::string& path, CaptureConfig& config) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "[WARN] Could not open config file " << path << std::endl;
+        return false;
+    }
+
+    try {
+        nlohmann::json root = nlohmann::json::parse(in);
+        if (!root.contains("parser") || !root["parser"].is_object()) {
+            return true;
+        }
+
+        const nlohmann::json& parser = root["parser"];
+        config.buffer_size = parser.value("buffer_size", config.buffer_size);
+        config.snaplen = parser.value("snaplen", config.snaplen);
+        config.immediate_mode = parser.value("immediate_mode", config.immediate_mode);
+        config.promiscuous = parser.value("promiscuous", config.promiscuous);
+        config.nano_precision = (parser.value("timestamp_precision",
+                                              std::string(config.nano_precision ? "nano" : "micro")) == "nano");
+
+        // "cpu_affinity": {"capture": "0", "workers": "2-5", ...} (빈 문자열은 고정하지 않음)
+        if (parser.contains("cpu_affinity") && parser["cpu_affinity"].is_object()) {
+            for (const auto& item : parser["cpu_affinity"].items()) {
+                std::string cpus = item.value().get<std::string>();
+                if (!cpus.empty()) {
+                    ThreadPlacement::parseAssignment(item.key() + "=" + cpus);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[WARN] Invalid config file " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    std::cout << "[Config] Loaded capture settings from " << path << std::endl;
+    return true;
 }
 
 // ============================================================================
@@ -109,7 +427,68 @@ int main(int argc, char* argv[]) {
     std::string parser_mode = getEnv("PARSER_MODE", "with-files");
     bool realtime = (parser_mode == "realtime");
     int num_threads = getEnvInt("PARSER_THREADS", 0);
-    std::string pcap_file = "";  // PCAP 파일 경로
+    bool inline_mode = getEnvBool("INLINE_PARSING", false);
+    std::vector<std::string> pcap_inputs;  // PCAP 파일/glob/디렉토리 (여러 개 가능)
+    std::string offline_reader_name = getEnv("OFFLINE_READER", "mmap");
+    int offline_chunk_packets = getEnvInt("OFFLINE_CHUNK_PACKETS", 4096);
+    double replay_speed = std::atof(getEnv("REPLAY_SPEED", "0").c_str());
+    double replay_pps = std::atof(getEnv("REPLAY_PPS", "0").c_str());
+    bool auto_filter = getEnvBool("AUTO_BPF_FILTER", false);
+    std::vector<std::string> auto_filter_protocols = splitList(getEnv("AUTO_BPF_PROTOCOLS", ""));
+    bool auto_filter_keep_tcp = getEnvBool("AUTO_BPF_KEEP_TCP_SESSION", false);
+
+    // 큐에 들어가는 패킷 슬롯 풀 (패킷마다 힙 할당 없음)
+    PacketPoolConfig pool_config;
+    pool_config.slots = static_cast<size_t>(std::max(1, getEnvInt("PACKET_POOL_SLOTS", 8192)));
+    pool_config.slot_bytes = static_cast<size_t>(std::max(0, getEnvInt("PACKET_POOL_SLOT_SIZE", 0)));
+    pool_config.hugepages = getEnvBool("PACKET_POOL_HUGEPAGES", false);
+    std::string overload_policy_name = getEnv("OVERLOAD_POLICY", "");
+    long long queue_max_bytes = std::atoll(getEnv("QUEUE_MAX_BYTES", "0").c_str());
+    int handoff_batch = getEnvInt("HANDOFF_BATCH", 32);
+    int handoff_timeout_us = getEnvInt("HANDOFF_TIMEOUT_US", 200);
+    std::string pipeline_spec = getEnv("PIPELINE_STAGES", "");
+    PipelineConfig pipeline_config;
+    pipeline_config.batch_size = static_cast<size_t>(std::max(1, getEnvInt("PIPELINE_BATCH", 64)));
+    pipeline_config.queue_batches = static_cast<size_t>(std::max(1, getEnvInt("PIPELINE_QUEUE_BATCHES", 32)));
+    ReassemblyConfig reassembly_config;
+    reassembly_config.max_bytes = static_cast<size_t>(std::max(0LL, std::atoll(getEnv("IP_FRAG_MAX_BYTES", "4194304").c_str())));
+    reassembly_config.timeout_sec = std::max(1, getEnvInt("IP_FRAG_TIMEOUT_SEC", 30));
+    TcpStreamConfig tcp_stream_config;
+    tcp_stream_config.max_bytes = static_cast<size_t>(std::max(0LL, std::atoll(getEnv("TCP_STREAM_MAX_BYTES", "8388608").c_str())));
+    tcp_stream_config.timeout_sec = std::max(1, getEnvInt("TCP_STREAM_TIMEOUT_SEC", 120));
+
+    // 라이브 캡처 백엔드 설정
+    CaptureConfig capture_config;
+
+    // config 파일은 다른 설정의 기본값이므로 getopt 이전에 먼저 읽음
+    std::string config_file = getEnv("PARSER_CONFIG", "");
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--config") == 0) {
+            config_file = argv[i + 1];
+        }
+    }
+    if (!config_file.empty()) {
+        loadParserConfig(config_file, capture_config);
+    }
+
+    // 스레드 배치: config 파일 < 환경 변수 < --cpu
+    if (!ThreadPlacement::parseAssignments(getEnv("CPU_AFFINITY", ""))) {
+        return 1;
+    }
+
+    capture_config.backend = getEnv("CAPTURE_BACKEND", "pcap");
+    capture_config.block_size = getEnvInt("TPACKET_BLOCK_SIZE", capture_config.block_size);
+    capture_config.block_count = getEnvInt("TPACKET_BLOCK_COUNT", capture_config.block_count);
+    capture_config.retire_timeout_ms = getEnvInt("TPACKET_RETIRE_TIMEOUT_MS", capture_config.retire_timeout_ms);
+    capture_config.fanout_mode = getEnv("FANOUT_MODE", "");
+    capture_config.fanout_group_id = getEnvInt("FANOUT_GROUP_ID", 0);
+    capture_config.poll_timeout_ms = getEnvInt("CAPTURE_POLL_TIMEOUT_MS", capture_config.poll_timeout_ms);
+    capture_config.snaplen = getEnvInt("PCAP_SNAPLEN", capture_config.snaplen);
+    capture_config.buffer_size = getEnvInt("PCAP_BUFFER_SIZE", capture_config.buffer_size);
+    capture_config.immediate_mode = getEnvBool("PCAP_IMMEDIATE", capture_config.immediate_mode);
+    capture_config.promiscuous = getEnvBool("PCAP_PROMISC", capture_config.promiscuous);
+    capture_config.nano_precision = (getEnv("PCAP_TSTAMP_PRECISION",
+                                            capture_config.nano_precision ? "nano" : "micro") == "nano");
 
     // 커맨드 라인 인자 파싱
     static struct option long_options[] = {
@@ -120,6 +499,42 @@ int main(int argc, char* argv[]) {
         {"rolling", required_argument, 0, 'r'},
         {"realtime", no_argument, 0, 1},
         {"threads", required_argument, 0, 't'},
+        {"capture-backend", required_argument, 0, 2},
+        {"tpacket-block-size", required_argument, 0, 3},
+        {"tpacket-block-count", required_argument, 0, 4},
+        {"tpacket-retire-ms", required_argument, 0, 5},
+        {"fanout", required_argument, 0, 6},
+        {"fanout-group", required_argument, 0, 7},
+        {"poll-timeout", required_argument, 0, 8},
+        {"snaplen", required_argument, 0, 9},
+        {"buffer-size", required_argument, 0, 10},
+        {"immediate", no_argument, 0, 11},
+        {"no-promisc", no_argument, 0, 12},
+        {"tstamp-precision", required_argument, 0, 13},
+        {"config", required_argument, 0, 14},
+        {"offline-reader", required_argument, 0, 15},
+        {"offline-chunk", required_argument, 0, 16},
+        {"replay-speed", required_argument, 0, 17},
+        {"replay-pps", required_argument, 0, 18},
+        {"auto-filter", no_argument, 0, 19},
+        {"auto-filter-protocols", required_argument, 0, 20},
+        {"auto-filter-keep-tcp", no_argument, 0, 21},
+        {"pool-slots", required_argument, 0, 22},
+        {"pool-slot-size", required_argument, 0, 23},
+        {"hugepages", no_argument, 0, 24},
+        {"handoff-batch", required_argument, 0, 25},
+        {"overload-policy", required_argument, 0, 27},
+        {"inline", no_argument, 0, 29},
+        {"cpu", required_argument, 0, 30},
+        {"pipeline", required_argument, 0, 31},
+        {"pipeline-batch", required_argument, 0, 32},
+        {"pipeline-queue", required_argument, 0, 33},
+        {"frag-max-bytes", required_argument, 0, 34},
+        {"frag-timeout", required_argument, 0, 35},
+        {"tcp-stream-max-bytes", required_argument, 0, 36},
+        {"tcp-stream-timeout", required_argument, 0, 37},
+        {"queue-max-bytes", required_argument, 0, 28},
+        {"handoff-timeout-us", required_argument, 0, 26},
         {"help", no_argument, 0, 'h'},
         {0, 0, 0, 0}
     };
@@ -132,7 +547,7 @@ int main(int argc, char* argv[]) {
                 interface = optarg;
                 break;
             case 'p':
-                pcap_file = optarg;
+                pcap_inputs.push_back(optarg);
                 break;
             case 'f':
                 bpf_filter = optarg;
@@ -149,6 +564,117 @@ int main(int argc, char* argv[]) {
             case 't':
                 num_threads = std::atoi(optarg);
                 break;
+            case 2:
+                capture_config.backend = optarg;
+                break;
+            case 3:
+                capture_config.block_size = std::atoi(optarg);
+                break;
+            case 4:
+                capture_config.block_count = std::atoi(optarg);
+                break;
+            case 5:
+                capture_config.retire_timeout_ms = std::atoi(optarg);
+                break;
+            case 6:
+                capture_config.fanout_mode = optarg;
+                break;
+            case 7:
+                capture_config.fanout_group_id = std::atoi(optarg);
+                break;
+            case 8:
+                capture_config.poll_timeout_ms = std::atoi(optarg);
+                break;
+            case 9:
+                capture_config.snaplen = std::atoi(optarg);
+                break;
+            case 10:
+                capture_config.buffer_size = std::atoi(optarg);
+                break;
+            case 11:
+                capture_config.immediate_mode = true;
+                break;
+            case 12:
+                capture_config.promiscuous = false;
+                break;
+            case 13:
+                capture_config.nano_precision = (std::string(optarg) == "nano");
+                break;
+            case 14:
+                // 이미 getopt 이전에 적용됨
+                break;
+            case 15:
+                offline_reader_name = optarg;
+                break;
+            case 16:
+                offline_chunk_packets = std::atoi(optarg);
+                break;
+            case 17:
+                replay_speed = std::atof(optarg);
+                break;
+            case 18:
+                replay_pps = std::atof(optarg);
+                break;
+            case 19:
+                auto_filter = true;
+                break;
+            case 20:
+                auto_filter = true;
+                auto_filter_protocols = splitList(optarg);
+                break;
+            case 21:
+                auto_filter_keep_tcp = true;
+                break;
+            case 22:
+                pool_config.slots = static_cast<size_t>(std::max(1, std::atoi(optarg)));
+                break;
+            case 23:
+                pool_config.slot_bytes = static_cast<size_t>(std::max(0, std::atoi(optarg)));
+                break;
+            case 24:
+                pool_config.hugepages = true;
+                break;
+            case 25:
+                handoff_batch = std::atoi(optarg);
+                break;
+            case 26:
+                handoff_timeout_us = std::atoi(optarg);
+                break;
+            case 27:
+                overload_policy_name = optarg;
+                break;
+            case 28:
+                queue_max_bytes = std::atoll(optarg);
+                break;
+            case 29:
+                inline_mode = true;
+                break;
+            case 30:
+                if (!ThreadPlacement::parseAssignment(optarg)) {
+                    return 1;
+                }
+                break;
+            case 31:
+                pipeline_spec = optarg;
+                break;
+            case 32:
+                pipeline_config.batch_size = static_cast<size_t>(std::max(1, std::atoi(optarg)));
+                break;
+            case 33:
+                pipeline_config.queue_batches = static_cast<size_t>(std::max(1, std::atoi(optarg)));
+                break;
+            case 34:
+                reassembly_config.max_bytes = static_cast<size_t>(std::max(0LL, std::atoll(optarg)));
+                break;
+            case 35:
+                reassembly_config.timeout_sec = std::max(1, std::atoi(optarg));
+                break;
+            case 36:
+                tcp_stream_config.max_bytes = static_cast<size_t>(std::max(0LL, std::atoll(optarg)));
+                break;
+            case 37:
+                tcp_stream_config.timeout_sec = std::max(1, std::atoi(optarg));
+                break;
             case 'h':
                 printUsage(argv[0]);
                 return 0;
@@ -158,7 +684,88 @@ int main(int argc, char* argv[]) {
         }
     }
 
-    // Signal handler 등록
+    // -p 뒤에 shell glob이 펼쳐진 나머지 파일들도 입력으로 받음
+    for (int i = optind; i < argc; ++i) {
+        pcap_inputs.push_back(argv[i]);
+    }
+
+    std::vector<std::string> pcap_files;
+    if (!pcap_inputs.empty()) {
+        pcap_files = OfflineMergeReader::expandInputs(pcap_inputs);
+        if (pcap_files.empty()) {
+            std::cerr << "[ERROR] No PCAP files found" << std::endl;
+            return 1;
+        }
+    }
+    bool offline_mode = !pcap_files.empty();
+
+    if (offline_reader_name != "mmap" && offline_reader_name != "pcap") {
+        std::cerr << "[ERROR] Unknown offline reader: " << offline_reader_name << std::endl;
+        return 1;
+    }
+    if (offline_chunk_packets <= 0) {
+        offline_chunk_packets = 4096;
+    }
+
+    // run-to-completion: 캡처 스레드 하나가 파싱까지 하므로 worker는 1개
+    if (inline_mode && !capture_config.fanout_mode.empty()) {
+        std::cerr << "[WARN] --inline is ignored with --fanout (fanout workers already parse their own sockets)" << std::endl;
+        inline_mode = false;
+    }
+    if (inline_mode) {
+        if (num_threads > 1) {
+            std::cerr << "[WARN] --inline uses the capture thread only, ignoring --threads " << num_threads << std::endl;
+        }
+        num_threads = 1;
+    }
+
+    // --threads 0(기본): 하드웨어 코어 수가 아니라 컨테이너 CPU 예산(cgroup quota, cpuset)으로 나눔
+    CpuBudget cpu_budget = CpuBudget::detect();
+    ThreadPlan thread_plan = ThreadPlan::fromBudget(cpu_budget, realtime,
+                                                    !offline_mode && !capture_config.fanout_mode.empty());
+    std::cout << "[Config] CPU budget: " << cpu_budget.describe() << std::endl;
+    if (num_threads == 0 && !inline_mode) {
+        num_threads = thread_plan.workers;
+        std::cout << "[Config] Thread plan: " << thread_plan.reason << std::endl;
+    }
+
+    // decode 뒤 단계의 스레드 수: Redis 왕복이 있는 enrich는 realtime이면 항상 분리,
+    // serialize/sink는 CPU 예산이 충분할 때만 분리 (run-to-completion은 지정하지 않으면 전부 inline)
+    if (!inline_mode) {
+        bool roomy = cpu_budget.cpus >= 4;
+        if (realtime) {
+            pipeline_config.threads[STAGE_ENRICH] = 1;
+            pipeline_config.threads[STAGE_SERIALIZE] = roomy ? std::max(1, thread_plan.sink) : 0;
+            pipeline_config.threads[STAGE_SINK] = roomy ? 1 : 0;
+        } else {
+            // 파일 모드는 UnifiedWriter lock 경합만 줄이면 되므로 worker가 여럿일 때 sink만 분리
+            pipeline_config.threads[STAGE_SINK] = (roomy && num_threads > 1) ? 1 : 0;
+        }
+    }
+    if (!pipeline_config.parse(pipeline_spec)) {
+        return 1;
+    }
+
+    // 큐가 가득 찼을 때: 파일은 잃지 않도록 대기, 라이브 캡처는 캡처를 막지 않도록 드롭
+    OverloadPolicy overload_policy = offline_mode ? OVERLOAD_BLOCK : OVERLOAD_DROP_NEWEST;
+    if (!overload_policy_name.empty() && !parseOverloadPolicy(overload_policy_name, overload_policy)) {
+        std::cerr << "[ERROR] Unknown overload policy: " << overload_policy_name << std::endl;
+        return 1;
+    }
+
+    ReplayPacer replay_pacer(replay_speed, replay_pps, capture_config.nano_precision);
+    if (replay_pacer.isEnabled() && offline_reader_name != "mmap") {
+        std::cerr << "[ERROR] Replay pacing requires --offline-reader mmap" << std::endl;
+        return 1;
+    }
+    if (replay_pacer.isEnabled() && !offline_mode) {
+        std::cerr << "[WARN] --replay-speed/--replay-pps only apply to PCAP input, ignoring" << std::endl;
+    }
+
+    // Signal handler 등록 (handler가 종료 eventfd에 기록하므로 먼저 생성)
+    if (!CaptureEventLoop::initShutdownEvent()) {
+        return 1;
+    }
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
 
@@ -184,7 +791,10 @@ int main(int argc, char* argv[]) {
     redis_config.password = getEnv("REDIS_PASSWORD", "");
     redis_config.db = getEnvInt("REDIS_DB", 0);
     redis_config.pool_size = getEnvInt("REDIS_POOL_SIZE", 8);
-    redis_config.async_writers = getEnvInt("REDIS_ASYNC_WRITERS", 2);
+    redis_config.async_writers = getEnvInt("REDIS_ASYNC_WRITERS", 0);
+    if (redis_config.async_writers <= 0) {
+        redis_config.async_writers = std::max(thread_plan.sink, 1);   // 0 = CPU 예산 기준
+    }
     redis_config.async_queue_size = getEnvInt("REDIS_ASYNC_QUEUE_SIZE", 10000);
     redis_config.timeout_ms = getEnvInt("REDIS_TIMEOUT_MS", 1000);
 
@@ -192,20 +802,44 @@ int main(int argc, char* argv[]) {
     // 설정 출력
     // ========================================================================
     std::cout << "[Config] Configuration:" << std::endl;
-    if (!pcap_file.empty()) {
+    if (offline_mode) {
         std::cout << "  Input Mode: PCAP File" << std::endl;
-        std::cout << "  PCAP File: " << pcap_file << std::endl;
+        if (pcap_files.size() == 1) {
+            std::cout << "  PCAP File: " << pcap_files[0] << std::endl;
+        } else {
+            std::cout << "  PCAP Files: " << pcap_files.size() << " (merged by timestamp)" << std::endl;
+        }
+        std::cout << "  Offline Reader: " << offline_reader_name << std::endl;
+        if (replay_pps > 0) {
+            std::cout << "  Replay: " << replay_pps << " pps" << std::endl;
+        } else if (replay_speed > 0) {
+            std::cout << "  Replay: " << replay_speed << "x original speed" << std::endl;
+        }
     } else {
         std::cout << "  Input Mode: Live Capture" << std::endl;
         std::cout << "  Network Interface: " << interface << std::endl;
+        if (capture_config.fanout_mode.empty()) {
+            std::cout << "  Capture Backend: " << capture_config.backend << std::endl;
+        } else {
+            std::cout << "  Capture Backend: tpacket_v3 + PACKET_FANOUT (" << capture_config.fanout_mode << ")" << std::endl;
+        }
+        std::cout << "  Snaplen: " << capture_config.snaplen << std::endl;
+        std::cout << "  Buffer Size: " << (capture_config.buffer_size > 0 ? std::to_string(capture_config.buffer_size) + " bytes" : "libpcap default") << std::endl;
+        std::cout << "  Immediate Mode: " << (capture_config.immediate_mode ? "Yes" : "No") << std::endl;
+        std::cout << "  Promiscuous: " << (capture_config.promiscuous ? "Yes" : "No") << std::endl;
     }
+    std::cout << "  Timestamp Precision: " << (capture_config.nano_precision ? "nano" : "micro") << std::endl;
     if (!bpf_filter.empty()) {
         std::cout << "  BPF Filter: " << bpf_filter << std::endl;
     }
     std::cout << "  Output Directory: " << output_dir << std::endl;
     std::cout << "  Rolling Interval: " << rolling_interval << " minutes" << std::endl;
     std::cout << "  Mode: " << (realtime ? "Realtime (no file output)" : "With file output") << std::endl;
-    std::cout << "  Worker Threads: " << (num_threads == 0 ? "Auto" : std::to_string(num_threads)) << std::endl;
+    if (inline_mode) {
+        std::cout << "  Worker Threads: none (run-to-completion on the capture thread)" << std::endl;
+    } else {
+        std::cout << "  Worker Threads: " << (num_threads == 0 ? "Auto" : std::to_string(num_threads)) << std::endl;
+    }
     std::cout << std::endl;
 
     // 파일 출력 모드일 때는 Elasticsearch/Redis 비활성화
@@ -251,22 +885,60 @@ int main(int argc, char* argv[]) {
         realtime  // disable_file_output
     );
 
-    // ========================================================================
-    // Worker 스레드 시작
-    // ========================================================================
-    std::cout << "[Init] Starting worker threads..." << std::endl;
-    g_parser->startWorkers();
+    ThreadPlacement::printTopology(inline_mode ? 0 : g_parser->getNumThreads(),
+                                   realtime ? redis_config.async_writers : 0);
+
+    // 파서 목록에서 BPF 생성 (분석하지 않는 트래픽은 커널에서 드롭)
+    if (auto_filter) {
+        // 실시간 Ethernet 인터페이스만 VLAN 절 추가 ("any"는 cooked 링크라 libpcap이 vlan을 컴파일하지 못함)
+        bool filter_vlan = !offline_mode && interface != "any";
+        std::string generated = g_parser->buildCaptureFilter(auto_filter_protocols, auto_filter_keep_tcp, filter_vlan);
+        if (generated.empty()) {
+            std::cerr << "[WARN] Auto BPF filter matched no parsers, capturing all traffic" << std::endl;
+        } else if (bpf_filter.empty()) {
+            bpf_filter = generated;
+        } else {
+            bpf_filter = "(" + bpf_filter + ") and (" + generated + ")";
+        }
+        std::cout << "[Config] Auto BPF filter: " << bpf_filter << std::endl;
+    }
 
     // ========================================================================
     // pcap 초기화
     // ========================================================================
     char errbuf[PCAP_ERRBUF_SIZE];
-    pcap_t* handle;
+    pcap_t* handle = nullptr;
+    std::unique_ptr<ICaptureBackend> backend;
+    std::unique_ptr<OfflineMergeReader> offline_reader;
+    bool fanout_active = false;
 
-    if (!pcap_file.empty()) {
-        // PCAP 파일 모드
+    if (offline_mode && offline_reader_name == "mmap") {
+        // PCAP 파일 모드: 파일을 mmap해서 chunk 단위로 worker에 분배 (여러 파일은 timestamp merge)
+        offline_reader = std::make_unique<OfflineMergeReader>(capture_config.nano_precision);
+        if (!offline_reader->open(pcap_files)) {
+            delete g_parser;
+            return 1;
+        }
+        for (size_t i = 0; i < offline_reader->getFileCount(); ++i) {
+            const OfflinePcapReader& reader = offline_reader->getReader(i);
+            std::cout << "[PCAP] Opened PCAP file: " << reader.getPath() << " (mmap reader, "
+                      << reader.getFormat() << ", " << (reader.getFileSize() / (1024 * 1024))
+                      << " MiB, link type " << reader.getDatalink() << ")" << std::endl;
+        }
+    } else if (offline_mode) {
+        if (pcap_files.size() > 1) {
+            std::cerr << "[ERROR] The pcap offline reader reads a single file; use --offline-reader mmap" << std::endl;
+            delete g_parser;
+            return 1;
+        }
+
+        // PCAP 파일 모드 (libpcap reader)
+        const std::string& pcap_file = pcap_files[0];
         std::cout << "[PCAP] Opening PCAP file: " << pcap_file << std::endl;
-        handle = pcap_open_offline(pcap_file.c_str(), errbuf);
+        handle = pcap_open_offline_with_tstamp_precision(
+            pcap_file.c_str(),
+            capture_config.nano_precision ? PCAP_TSTAMP_PRECISION_NANO : PCAP_TSTAMP_PRECISION_MICRO,
+            errbuf);
         if (handle == nullptr) {
             std::cerr << "[ERROR] Could not open PCAP file " << pcap_file << ": " << errbuf << std::endl;
             delete g_parser;
@@ -274,45 +946,128 @@ int main(int argc, char* argv[]) {
         }
     } else {
         // 라이브 캡처 모드
-        std::cout << "[PCAP] Opening interface: " << interface << std::endl;
-        handle = pcap_open_live(interface.c_str(), 65535, 1, 1000, errbuf);
-        if (handle == nullptr) {
-            std::cerr << "[ERROR] Could not open device " << interface << ": " << errbuf << std::endl;
-            delete g_parser;
-            return 1;
+        capture_config.interface = interface;
+
+        if (!capture_config.fanout_mode.empty()) {
+            fanout_active = attachFanoutBackends(g_parser, capture_config, bpf_filter);
+            if (!fanout_active) {
+                std::cerr << "[WARN] PACKET_FANOUT capture unavailable, falling back to a single capture socket" << std::endl;
+                capture_config.fanout_mode.clear();
+            }
         }
     }
 
-    // BPF 필터 설정
-    if (!bpf_filter.empty()) {
-        struct bpf_program fp;
-        bpf_u_int32 net = 0;
+    if (!offline_mode && !fanout_active) {
+        std::cout << "[PCAP] Opening interface: " << interface
+                  << " (backend: " << capture_config.backend << ")" << std::endl;
 
-        std::cout << "[PCAP] Compiling BPF filter: " << bpf_filter << std::endl;
-        if (pcap_compile(handle, &fp, bpf_filter.c_str(), 0, net) == -1) {
-            std::cerr << "[ERROR] Could not compile filter: " << pcap_geterr(handle) << std::endl;
-            pcap_close(handle);
+        backend = createCaptureBackend(capture_config);
+        if (!backend) {
+            std::cerr << "[ERROR] Unknown capture backend: " << capture_config.backend << std::endl;
             delete g_parser;
             return 1;
         }
 
-        if (pcap_setfilter(handle, &fp) == -1) {
-            std::cerr << "[ERROR] Could not set filter: " << pcap_geterr(handle) << std::endl;
+        if (!backend->open()) {
+            if (backend->getName() == "pcap") {
+                delete g_parser;
+                return 1;
+            }
+
+            // libpcap으로 fallback
+            std::cerr << "[WARN] " << backend->getName() << " backend unavailable, falling back to libpcap" << std::endl;
+            capture_config.backend = "pcap";
+            backend = createCaptureBackend(capture_config);
+            if (!backend->open()) {
+                delete g_parser;
+                return 1;
+            }
+        }
+    }
+
+    // BPF 필터 설정 (fanout 소켓은 열 때 이미 적용됨)
+    if (!bpf_filter.empty() && !fanout_active) {
+        std::cout << "[PCAP] Compiling BPF filter: " << bpf_filter << std::endl;
+
+        if (backend) {
+            if (!backend->setFilter(bpf_filter)) {
+                backend.reset();
+                delete g_parser;
+                return 1;
+            }
+        } else if (offline_reader) {
+            if (!offline_reader->setFilter(bpf_filter)) {
+                delete g_parser;
+                return 1;
+            }
+        } else {
+            struct bpf_program fp;
+            bpf_u_int32 net = 0;
+
+            if (pcap_compile(handle, &fp, bpf_filter.c_str(), 0, net) == -1) {
+                std::cerr << "[ERROR] Could not compile filter: " << pcap_geterr(handle) << std::endl;
+                pcap_close(handle);
+                delete g_parser;
+                return 1;
+            }
+
+            if (pcap_setfilter(handle, &fp) == -1) {
+                std::cerr << "[ERROR] Could not set filter: " << pcap_geterr(handle) << std::endl;
+                pcap_freecode(&fp);
+                pcap_close(handle);
+                delete g_parser;
+                return 1;
+            }
+
             pcap_freecode(&fp);
-            pcap_close(handle);
+        }
+        std::cout << "[PCAP] BPF filter applied successfully" << std::endl;
+    }
+
+    // ========================================================================
+    // Worker 스레드 시작
+    // ========================================================================
+    if (handle) {
+        g_parser->setTimestampPrecision(pcap_get_tstamp_precision(handle));
+        g_parser->setDatalink(pcap_datalink(handle));
+    } else if (backend) {
+        g_parser->setTimestampPrecision(backend->getTimestampPrecision());
+        g_parser->setDatalink(backend->getDatalink());
+    } else {
+        g_parser->setTimestampPrecision(capture_config.nano_precision ? PCAP_TSTAMP_PRECISION_NANO
+                                                                      : PCAP_TSTAMP_PRECISION_MICRO);
+    }
+
+    // 공유 큐를 쓰는 경로(단일 소켓 라이브 캡처, libpcap 오프라인 reader)만 슬롯 풀이 필요
+    g_parser->setInlineMode(inline_mode);
+    if (!offline_reader && !fanout_active && !inline_mode) {
+        pool_config.numa_node = ThreadPlacement::nodeForRole(ThreadRole::CAPTURE);
+        if (!g_parser->initPacketPool(pool_config, capture_config.snaplen)) {
+            if (handle) pcap_close(handle);
+            backend.reset();
             delete g_parser;
             return 1;
         }
-
-        pcap_freecode(&fp);
-        std::cout << "[PCAP] BPF filter applied successfully" << std::endl;
+        g_parser->setOverloadPolicy(overload_policy, static_cast<size_t>(std::max(0LL, queue_max_bytes)));
+        std::cout << "[Config] Ingest queue: " << pool_config.slots << " packets"
+                  << (queue_max_bytes > 0 ? ", " + std::to_string(queue_max_bytes) + " bytes" : std::string())
+                  << ", overload policy " << overloadPolicyName(overload_policy) << std::endl;
+        g_parser->setHandoffBatch(static_cast<size_t>(std::max(1, handoff_batch)), handoff_timeout_us);
     }
 
+    g_parser->setPipelineConfig(pipeline_config);
+    g_parser->setReassemblyConfig(reassembly_config);
+    g_parser->setTcpStreamConfig(tcp_stream_config);
+
+    std::cout << "[Init] Starting worker threads..." << std::endl;
+    g_parser->startWorkers();
+
     // ========================================================================
     // 패킷 캡처 시작
     // ========================================================================
+    ThreadPlacement::apply(ThreadRole::CAPTURE);
     std::cout << "\n" << std::string(70, '=') << std::endl;
-    if (!pcap_file.empty()) {
+    if (offline_mode) {
         std::cout << "===  Processing PCAP file. Press Ctrl+C to stop...   ===" << std::endl;
     } else {
         std::cout << "===  Packet capture started. Press Ctrl+C to stop...  ===" << std::endl;
@@ -322,10 +1077,50 @@ int main(int argc, char* argv[]) {
     int packet_count = 0;
     auto last_stats = std::chrono::steady_clock::now();
 
-    if (!pcap_file.empty()) {
-        // PCAP 파일 모드: 블로킹 방식으로 모든 패킷 처리
+    if (offline_reader) {
+        // PCAP 파일 모드: 레코드 경계만 순차로 찾고 디코딩은 worker들이 병렬 처리
+        std::cout << "[PCAP] Reading packets from file..." << std::endl;
+        auto read_start = std::chrono::steady_clock::now();
+        if (replay_pacer.isEnabled()) {
+            replayOfflinePackets(*offline_reader, replay_pacer, static_cast<size_t>(offline_chunk_packets));
+        } else {
+            while (g_running) {
+                auto chunk = std::make_shared<OfflineChunk>();
+                if (!offline_reader->nextChunk(*chunk, static_cast<size_t>(offline_chunk_packets))) {
+                    break;
+                }
+                g_parser->parseChunk(std::move(chunk));
+            }
+        }
+
+        if (!g_running) {
+            std::cout << "[PCAP] File processing interrupted by user" << std::endl;
+        } else {
+            std::cout << "[PCAP] File reading completed (" << offline_reader->getPacketsRead() << " packets";
+            if (offline_reader->getPacketsFiltered() > 0) {
+                std::cout << ", " << offline_reader->getPacketsFiltered() << " filtered";
+            }
+            std::cout << ")" << std::endl;
+        }
+
+        std::cout << "[PCAP] Waiting for all packets to be processed..." << std::endl;
+        g_parser->waitForCompletion();
+        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - read_start).count();
+        std::cout << "[PCAP] All packets processed successfully in " << elapsed_ms << " ms" << std::endl;
+
+        if (replay_pacer.isEnabled()) {
+            double elapsed = replay_pacer.getElapsedSeconds();
+            std::cout << "[Replay] Sent " << replay_pacer.getPacketsSent() << " packets in "
+                      << static_cast<uint64_t>(elapsed * 1000) << " ms ("
+                      << static_cast<uint64_t>(elapsed > 0 ? replay_pacer.getPacketsSent() / elapsed : 0) << " pps), "
+                      << replay_pacer.getPacketsLate() << " late, max lag " << replay_pacer.getMaxLagMs() << " ms"
+                      << std::endl;
+        }
+    } else if (offline_mode) {
+        // PCAP 파일 모드 (libpcap reader): 블로킹 방식으로 모든 패킷 처리
         std::cout << "[PCAP] Reading packets from file..." << std::endl;
-        int result = pcap_loop(handle, 0, packetCallback, reinterpret_cast<u_char*>(g_parser));
+        int result = pcap_loop(handle, 0, pcapFileCallback, reinterpret_cast<u_char*>(g_parser));
 
         if (result == -1) {
             std::cerr << "[ERROR] pcap_loop error: " << pcap_geterr(handle) << std::endl;
@@ -340,26 +1135,57 @@ int main(int argc, char* argv[]) {
         g_parser->waitForCompletion();
         std::cout << "[PCAP] All packets processed successfully" << std::endl;
     } else {
-        // 라이브 캡처 모드: non-blocking 방식
-        pcap_setnonblock(handle, 1, errbuf);
+        // 라이브 캡처 모드: 캡처 fd와 종료 eventfd를 epoll로 대기
+        // fanout 모드에서는 worker가 각자 소켓에서 캡처하므로 메인 스레드는 통계만 담당
+        CaptureEventLoop event_loop(capture_config.poll_timeout_ms);
+        if (!event_loop.open(fanout_active ? -1 : backend->getSelectableFd())) {
+            g_running = false;
+        }
 
         while (g_running) {
-            int result = pcap_dispatch(handle, 100, packetCallback, reinterpret_cast<u_char*>(g_parser));
-
-            if (result == -1) {
-                std::cerr << "[ERROR] pcap_dispatch error: " << pcap_geterr(handle) << std::endl;
-                break;
-            } else if (result == 0) {
-                // No packets, sleep briefly
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            } else {
+            int result = 0;
+            if (!fanout_active) {
+                result = backend->dispatch(100, packetCallback, reinterpret_cast<u_char*>(g_parser));
+                if (result == -1) {
+                    break;
+                }
                 packet_count += result;
             }
 
+            if (result == 0) {
+                // 준비된 패킷이 없으면 모아 둔 배치를 넘기고 fd가 readable해지거나 종료 요청/timeout까지 블록
+                if (!fanout_active) {
+                    g_parser->flushHandoff();
+                }
+                CaptureEventLoop::WaitResult wait_result = event_loop.wait();
+                if (wait_result == CaptureEventLoop::SHUTDOWN || wait_result == CaptureEventLoop::WAIT_ERROR) {
+                    break;
+                }
+            }
+
             // 통계 출력 (30초마다)
             auto now = std::chrono::steady_clock::now();
             if (std::chrono::duration_cast<std::chrono::seconds>(now - last_stats).count() >= 30) {
-                std::cout << "[Stats] Packets captured: " << packet_count << std::endl;
+                CaptureStats capture_stats;
+                bool has_stats = fanout_active ? g_parser->getCaptureStats(capture_stats)
+                                               : backend->getStats(capture_stats);
+
+                if (!fanout_active) {
+                    std::cout << "[Stats] Packets captured: " << packet_count << std::endl;
+                    printOverloadStats(g_parser->getOverloadStats());
+                    printHandoffStats(g_parser->getHandoffStats());
+                }
+                printPipelineStats(g_parser->getPipeline());
+                printReassemblyStats(g_parser->getReassemblyStats());
+                printTcpStreamStats(g_parser->getTcpStreamStats());
+                if (has_stats) {
+                    std::cout << "[Stats] Kernel: received=" << capture_stats.packets_received
+                              << ", dropped=" << capture_stats.packets_dropped;
+                    if (capture_stats.ring_freezes > 0) {
+                        std::cout << ", ring_freezes=" << capture_stats.ring_freezes;
+                    }
+                    std::cout << std::endl;
+                }
 
                 // Redis 통계
                 if (g_parser->getRedisCache() && g_parser->getRedisCache()->isConnected()) {
@@ -377,19 +1203,23 @@ int main(int argc, char* argv[]) {
     // ========================================================================
     std::cout << "\n[Main] Shutting down..." << std::endl;
 
-    // pcap 종료
-    pcap_close(handle);
-    std::cout << "[PCAP] Closed" << std::endl;
-
     // Worker 종료
     std::cout << "[Main] Stopping workers..." << std::endl;
     // PCAP 파일 모드에서는 이미 waitForCompletion()을 호출했으므로 바로 stopWorkers() 호출
-    if (pcap_file.empty()) {
+    if (!offline_mode) {
         // 라이브 캡처 모드에서만 waitForCompletion() 호출
         g_parser->waitForCompletion();
     }
     g_parser->stopWorkers();
 
+    // pcap 종료 (worker가 ring 블록을 모두 반환한 뒤에 닫아야 함)
+    if (handle) {
+        pcap_close(handle);
+    }
+    backend.reset();
+    offline_reader.reset();
+    std::cout << "[PCAP] Closed" << std::endl;
+
     // 최종 flush
     if (!realtime) {
         std::cout << "[Main] Generating final output..." << std::endl;
@@ -401,6 +1231,14 @@ int main(int argc, char* argv[]) {
     std::cout << "===                   Final Statistics                    ===" << std::endl;
     std::cout << std::string(70, '=') << std::endl;
 
+    printOverloadStats(g_parser->getOverloadStats());
+    if (g_parser->getHandoffStats().batches > 0) {
+        printHandoffStats(g_parser->getHandoffStats());
+    }
+    printPipelineStats(g_parser->getPipeline());
+    printReassemblyStats(g_parser->getReassemblyStats());
+    printTcpStreamStats(g_parser->getTcpStreamStats());
+
     if (g_parser->getRedisCache() && g_parser->getRedisCache()->isConnected()) {
         g_parser->getRedisCache()->printStats();
     }
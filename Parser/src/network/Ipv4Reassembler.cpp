@@ -0,0 +1,193 @@
+#include "Ipv4Reassembler.h"
+#include <algorithm>
+#include <cstring>
+#include "network_headers.h"
+#include "flow_hash.h"
+
+// 조각 offset은 8바이트 단위 13비트, IPv4 datagram 최대 길이는 65535
+static const uint32_t MAX_DATAGRAM = 65535;
+
+size_t Ipv4Reassembler::KeyHash::operator()(const Key& key) const {
+    uint32_t h = flow_hash::mix(key.protocol, key.src);
+    h = flow_hash::mix(h, key.dst);
+    h = flow_hash::mix(h, key.id);
+    return flow_hash::finalize(h);
+}
+
+Ipv4Reassembler::Ipv4Reassembler(const ReassemblyConfig& config)
+    : m_config(config) {}
+
+const u_char* Ipv4Reassembler::add(const struct pcap_pkthdr* header, const u_char* packet, uint32_t l3_offset,
+                                   struct pcap_pkthdr& whole) {
+    if (header->caplen < l3_offset + sizeof(IPHeader)) {
+        m_invalid.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    const IPHeader* ip = reinterpret_cast<const IPHeader*>(packet + l3_offset);
+    uint32_t ip_hl = ip->hl * 4u;
+    uint32_t ip_len = ntohs(ip->len);
+    uint16_t frag = ntohs(ip->off);
+    uint32_t begin = (frag & 0x1fffu) * 8u;
+    bool more = (frag & 0x2000) != 0;
+
+    // 조각 payload 전체가 캡처되어 있어야 하고, 마지막이 아닌 조각은 8바이트 배수여야 함
+    if (ip_hl < sizeof(IPHeader) || ip_len <= ip_hl || header->caplen < l3_offset + ip_len) {
+        m_invalid.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    uint32_t frag_len = ip_len - ip_hl;
+    uint32_t end = begin + frag_len;
+    if ((more && frag_len % 8 != 0) || ip_hl + end > MAX_DATAGRAM) {
+        m_invalid.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    m_fragments.fetch_add(1, std::memory_order_relaxed);
+    expire(header->ts.tv_sec);
+
+    Key key;
+    std::memcpy(&key.src, &ip->ip_src, 4);
+    std::memcpy(&key.dst, &ip->ip_dst, 4);
+    key.id = ip->id;
+    key.protocol = ip->p;
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        it = m_entries.emplace(key, Entry()).first;
+        it->second.first_seen = header->ts.tv_sec;
+    }
+
+    // 이 조각으로 늘어나는 메모리만큼 다른 entry를 밀어냄 (그래도 모자라면 이 datagram을 포기)
+    size_t headers_len = (begin == 0) ? l3_offset + ip_hl : 0;
+    size_t needed = headers_len + (end > it->second.payload.size() ? end - it->second.payload.size() : 0);
+    if (m_bytes_in_use + needed > m_config.max_bytes && !makeRoom(needed, key)) {
+        erase(it);
+        m_evicted_memory.fetch_add(1, std::memory_order_relaxed);
+        m_bytes_snapshot.store(m_bytes_in_use, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Entry& entry = it->second;
+    size_t before = entry.bytes();
+    if (begin == 0) {
+        entry.headers.assign(packet, packet + l3_offset + ip_hl);
+        entry.l3_offset = l3_offset;
+    }
+    if (end > entry.payload.size()) {
+        entry.payload.resize(end);
+    }
+    std::memcpy(entry.payload.data() + begin, packet + l3_offset + ip_hl, frag_len);
+    addRange(entry, begin, end);
+
+    if (!more) {
+        if (entry.has_last && entry.total_len != end) {
+            m_invalid.fetch_add(1, std::memory_order_relaxed);
+        }
+        entry.total_len = end;
+        entry.has_last = true;
+    }
+    m_bytes_in_use += entry.bytes() - before;
+
+    // 마지막 조각보다 뒤에 데이터가 있으면 datagram 전체를 버림
+    if (entry.has_last && entry.payload.size() > entry.total_len) {
+        m_invalid.fetch_add(1, std::memory_order_relaxed);
+        erase(it);
+        m_bytes_snapshot.store(m_bytes_in_use, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    if (!isComplete(entry)) {
+        m_bytes_snapshot.store(m_bytes_in_use, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // 첫 조각의 헤더 + payload를 하나의 패킷으로 (IP 길이와 fragment 필드만 고침)
+    m_output.assign(entry.headers.begin(), entry.headers.end());
+    m_output.insert(m_output.end(), entry.payload.begin(), entry.payload.begin() + entry.total_len);
+    IPHeader* out_ip = reinterpret_cast<IPHeader*>(m_output.data() + entry.l3_offset);
+    uint32_t out_hl = out_ip->hl * 4u;
+    out_ip->len = htons(static_cast<uint16_t>(out_hl + entry.total_len));
+    out_ip->off = static_cast<uint16_t>(out_ip->off & htons(0x4000));
+
+    whole.ts = header->ts;
+    whole.caplen = static_cast<bpf_u_int32>(m_output.size());
+    whole.len = whole.caplen;
+
+    erase(it);
+    m_completed.fetch_add(1, std::memory_order_relaxed);
+    m_bytes_snapshot.store(m_bytes_in_use, std::memory_order_relaxed);
+    return m_output.data();
+}
+
+void Ipv4Reassembler::addStatsTo(ReassemblyStats& stats) const {
+    stats.fragments += m_fragments.load(std::memory_order_relaxed);
+    stats.completed += m_completed.load(std::memory_order_relaxed);
+    stats.timed_out += m_timed_out.load(std::memory_order_relaxed);
+    stats.evicted_memory += m_evicted_memory.load(std::memory_order_relaxed);
+    stats.invalid += m_invalid.load(std::memory_order_relaxed);
+    stats.bytes_in_use += m_bytes_snapshot.load(std::memory_order_relaxed);
+}
+
+// 1초에 한 번만 테이블 전체를 훑음
+void Ipv4Reassembler::expire(time_t now) {
+    if (now == m_last_sweep) return;
+    m_last_sweep = now;
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (now - it->second.first_seen >= m_config.timeout_sec) {
+            auto expired = it++;
+            erase(expired);
+            m_timed_out.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// 가장 오래된 entry부터 needed 바이트가 들어갈 때까지 제거 (keep은 제외)
+bool Ipv4Reassembler::makeRoom(size_t needed, const Key& keep) {
+    if (needed > m_config.max_bytes) return false;
+
+    while (m_bytes_in_use + needed > m_config.max_bytes) {
+        auto oldest = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->first == keep) continue;
+            if (oldest == m_entries.end() || it->second.first_seen < oldest->second.first_seen) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_entries.end()) return false;
+        erase(oldest);
+        m_evicted_memory.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void Ipv4Reassembler::erase(std::unordered_map<Key, Entry, KeyHash>::iterator it) {
+    m_bytes_in_use -= it->second.bytes();
+    m_entries.erase(it);
+}
+
+void Ipv4Reassembler::addRange(Entry& entry, uint32_t begin, uint32_t end) {
+    auto& ranges = entry.ranges;
+    ranges.insert(std::lower_bound(ranges.begin(), ranges.end(), std::make_pair(begin, end)),
+                  std::make_pair(begin, end));
+
+    // 겹치거나 맞닿은 구간을 하나로 병합
+    std::vector<std::pair<uint32_t, uint32_t>> merged;
+    merged.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        if (!merged.empty() && range.first <= merged.back().second) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        } else {
+            merged.push_back(range);
+        }
+    }
+    ranges.swap(merged);
+}
+
+bool Ipv4Reassembler::isComplete(const Entry& entry) {
+    return entry.has_last && !entry.headers.empty() && entry.ranges.size() == 1 &&
+           entry.ranges[0].first == 0 && entry.ranges[0].second == entry.total_len;
+}
@@ -0,0 +1,92 @@
+#ifndef IPV4_REASSEMBLER_H
+#define IPV4_REASSEMBLER_H
+
+#include <pcap.h>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include <unordered_map>
+#include <vector>
+
+struct ReassemblyConfig {
+    size_t max_bytes = 4 * 1024 * 1024;   // 재조립 중인 조각 버퍼 합계 한도 (PacketParser가 worker 수로 나눔)
+    int timeout_sec = 30;                 // 첫 조각부터 이 시간(패킷 timestamp 기준) 안에 완성되지 않으면 폐기
+};
+
+// 재조립 결과 (worker들의 카운터를 합친 스냅샷)
+struct ReassemblyStats {
+    uint64_t fragments = 0;         // 테이블에 들어온 조각
+    uint64_t completed = 0;         // 완성된 datagram
+    uint64_t timed_out = 0;         // timeout으로 폐기된 entry
+    uint64_t evicted_memory = 0;    // 메모리 한도 때문에 밀려난 entry
+    uint64_t invalid = 0;           // 길이/offset이 맞지 않아 버린 조각
+    size_t bytes_in_use = 0;
+};
+
+// IPv4 조각 재조립 테이블 (worker 하나가 소유, lock 없음)
+// 키는 (src, dst, id, protocol)이고, 조각이 모두 모이면 첫 조각의 L2/IP 헤더 뒤에 payload를 이어 붙인
+// 하나의 패킷으로 돌려줍니다. 조각이 아닌 패킷은 이 테이블을 거치지 않습니다.
+class Ipv4Reassembler {
+public:
+    explicit Ipv4Reassembler(const ReassemblyConfig& config = ReassemblyConfig());
+
+    void configure(const ReassemblyConfig& config) { m_config = config; }
+
+    // l3_offset은 L2 헤더(VLAN 태그 포함) 길이
+    // datagram이 완성되면 whole에 헤더를 채우고 다음 add() 호출 전까지 유효한 버퍼를 반환, 아니면 nullptr
+    const u_char* add(const struct pcap_pkthdr* header, const u_char* packet, uint32_t l3_offset,
+                      struct pcap_pkthdr& whole);
+
+    void addStatsTo(ReassemblyStats& stats) const;
+
+private:
+    struct Key {
+        uint32_t src;
+        uint32_t dst;
+        uint16_t id;
+        uint8_t protocol;
+
+        bool operator==(const Key& other) const {
+            return src == other.src && dst == other.dst && id == other.id && protocol == other.protocol;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        time_t first_seen = 0;
+        std::vector<u_char> headers;                          // 첫 조각(offset 0)의 L2 + IP 헤더
+        uint32_t l3_offset = 0;                               // headers 안의 IP 헤더 위치 (조각마다 VLAN 태그 수가 다를 수 있음)
+        std::vector<u_char> payload;                          // IP payload, offset 위치에 복사
+        std::vector<std::pair<uint32_t, uint32_t>> ranges;    // 받은 [begin, end) 구간 (정렬, 병합)
+        uint32_t total_len = 0;                               // 마지막 조각(MF=0)을 받으면 설정
+        bool has_last = false;
+
+        size_t bytes() const { return headers.size() + payload.size(); }
+    };
+
+    ReassemblyConfig m_config;
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    size_t m_bytes_in_use = 0;
+    time_t m_last_sweep = 0;
+    std::vector<u_char> m_output;
+
+    // 다른 스레드에서 통계만 읽음
+    std::atomic<uint64_t> m_fragments{0};
+    std::atomic<uint64_t> m_completed{0};
+    std::atomic<uint64_t> m_timed_out{0};
+    std::atomic<uint64_t> m_evicted_memory{0};
+    std::atomic<uint64_t> m_invalid{0};
+    std::atomic<size_t> m_bytes_snapshot{0};
+
+    void expire(time_t now);
+    bool makeRoom(size_t needed, const Key& keep);
+    void erase(std::unordered_map<Key, Entry, KeyHash>::iterator it);
+    static void addRange(Entry& entry, uint32_t begin, uint32_t end);
+    static bool isComplete(const Entry& entry);
+};
+
+#endif // IPV4_REASSEMBLER_H
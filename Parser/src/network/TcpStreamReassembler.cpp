@@ -0,0 +1,267 @@
+#include "TcpStreamReassembler.h"
+#include <cstring>
+#include "network_headers.h"
+
+// Modbus/TCP ADU 최대 260바이트 = MBAP 6 + length 254
+static const uint16_t MBAP_MAX_LENGTH = 254;
+// TPKT 4 + COTP DT 3
+static const uint16_t TPKT_MIN_LENGTH = 7;
+static const size_t XGT_HEADER_SIZE = 20;
+
+int tcpFrameLength(TcpFraming framing, const u_char* data, size_t size) {
+    switch (framing) {
+        case FRAMING_MBAP: {
+            if (size < 6) return 0;
+            if (data[2] != 0x00 || data[3] != 0x00) return -1;
+            uint16_t length = static_cast<uint16_t>((data[4] << 8) | data[5]);
+            if (length < 2 || length > MBAP_MAX_LENGTH) return -1;
+            return 6 + length;
+        }
+        case FRAMING_TPKT: {
+            if (size < 4) return 0;
+            if (data[0] != 0x03 || data[1] != 0x00) return -1;
+            uint16_t length = static_cast<uint16_t>((data[2] << 8) | data[3]);
+            if (length < TPKT_MIN_LENGTH) return -1;
+            return length;
+        }
+        case FRAMING_XGT: {
+            size_t prefix = size < 8 ? size : 8;
+            if (std::memcmp(data, "LSIS-XGT", prefix) != 0) return -1;
+            if (size < XGT_HEADER_SIZE) return 0;
+            uint16_t length = static_cast<uint16_t>(data[16] | (data[17] << 8));
+            return static_cast<int>(XGT_HEADER_SIZE) + length;
+        }
+        default:
+            return -1;
+    }
+}
+
+TcpStreamReassembler::TcpStreamReassembler(const TcpStreamConfig& config)
+    : m_config(config) {}
+
+int TcpStreamReassembler::add(const PacketInfo& info, TcpFraming framing, const PduHandler& handler) {
+    Key key;
+    key.flow = info.flowKey(&key.reverse);
+
+    bool closing = (info.tcp_flags & (TH_FIN | TH_RST)) != 0;
+
+    // payload 없는 segment는 sequence 기준점만 맞추고 그대로 파싱되게 둠
+    if (info.payload_size <= 0 || !info.payload) {
+        auto it = m_streams.find(key);
+        if (closing) {
+            if (it != m_streams.end()) erase(it);
+        } else if (info.tcp_flags & TH_SYN) {
+            if (it == m_streams.end()) it = m_streams.emplace(key, Stream()).first;
+            m_bytes_in_use -= it->second.bytes();
+            it->second = Stream();
+            it->second.next_seq = info.tcp_seq + 1;
+            it->second.last_seen = info.ts.tv_sec;
+        }
+        updateSnapshot();
+        return -1;
+    }
+
+    m_segments.fetch_add(1, std::memory_order_relaxed);
+    expire(info.ts.tv_sec);
+
+    auto it = m_streams.find(key);
+    if (it == m_streams.end()) {
+        // SYN을 못 본 stream (캡처 도중 시작)은 첫 segment부터 이어 붙임
+        it = m_streams.emplace(key, Stream()).first;
+        it->second.next_seq = info.tcp_seq;
+    }
+    Stream& stream = it->second;
+    stream.last_seen = info.ts.tv_sec;
+    size_t before = stream.bytes();
+
+    uint32_t seq = info.tcp_seq;
+    const u_char* data = info.payload;
+    size_t size = static_cast<size_t>(info.payload_size);
+    int32_t ahead = static_cast<int32_t>(seq - stream.next_seq);
+
+    int count = 0;
+    bool framing_error = false;
+    if (ahead < 0) {
+        // 재전송: 이미 이어 붙인 부분은 잘라내고 새 데이터만 사용
+        size_t seen = static_cast<size_t>(-static_cast<int64_t>(ahead));
+        if (seen >= size) {
+            m_retransmissions.fetch_add(1, std::memory_order_relaxed);
+            size = 0;
+        } else {
+            m_overlaps.fetch_add(1, std::memory_order_relaxed);
+            data += seen;
+            size -= seen;
+        }
+    } else if (ahead > 0) {
+        if (static_cast<int>(stream.held.size()) < m_config.max_out_of_order &&
+            stream.bytes() + size <= m_config.max_stream_bytes) {
+            // 앞선 segment가 올 때까지 보관 (같은 seq가 다시 오면 긴 쪽을 유지)
+            auto& held = stream.held[seq];
+            if (held.size() < size) {
+                stream.held_bytes += size - held.size();
+                held.assign(data, data + size);
+            }
+            m_out_of_order.fetch_add(1, std::memory_order_relaxed);
+            size = 0;
+        } else {
+            // 더 기다릴 수 없으면 빠진 구간을 포기하고 이 segment부터 다시 시작
+            m_gaps.fetch_add(1, std::memory_order_relaxed);
+            stream.buffer.clear();
+            stream.held.clear();
+            stream.held_bytes = 0;
+            stream.next_seq = seq;
+        }
+    }
+
+    if (size > 0) {
+        count += deliver(stream, data, size, framing, handler, framing_error);
+        count += drainHeld(stream, framing, handler, framing_error);
+    }
+
+    m_bytes_in_use += stream.bytes();
+    m_bytes_in_use -= before;
+
+    if (closing) {
+        erase(it);
+    } else if (m_bytes_in_use > m_config.max_bytes) {
+        makeRoom(key);
+    }
+    updateSnapshot();
+
+    m_pdus.fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+    if (framing_error) {
+        m_framing_errors.fetch_add(1, std::memory_order_relaxed);
+        if (count == 0) return -1;
+    }
+    return count;
+}
+
+// 이어지는 데이터를 붙이고 완성된 PDU를 handler로 넘김
+int TcpStreamReassembler::deliver(Stream& stream, const u_char* data, size_t size, TcpFraming framing,
+                                  const PduHandler& handler, bool& framing_error) {
+    stream.next_seq += static_cast<uint32_t>(size);
+    int count = 0;
+
+    if (stream.buffer.empty()) {
+        // 남은 조각이 없으면 segment 안의 PDU는 복사 없이 전달
+        while (size > 0) {
+            int length = tcpFrameLength(framing, data, size);
+            if (length < 0) {
+                framing_error = true;
+                return count;
+            }
+            if (length == 0 || static_cast<size_t>(length) > size) break;
+            handler(data, length);
+            count++;
+            data += length;
+            size -= static_cast<size_t>(length);
+        }
+        if (size > 0) {
+            stream.buffer.assign(data, data + size);
+        }
+        return count;
+    }
+
+    stream.buffer.insert(stream.buffer.end(), data, data + size);
+    size_t pos = 0;
+    while (pos < stream.buffer.size()) {
+        int length = tcpFrameLength(framing, stream.buffer.data() + pos, stream.buffer.size() - pos);
+        if (length < 0) {
+            framing_error = true;
+            stream.buffer.clear();
+            return count;
+        }
+        if (length == 0 || static_cast<size_t>(length) > stream.buffer.size() - pos) break;
+        handler(stream.buffer.data() + pos, length);
+        m_buffered_pdus.fetch_add(1, std::memory_order_relaxed);
+        count++;
+        pos += static_cast<size_t>(length);
+    }
+    stream.buffer.erase(stream.buffer.begin(), stream.buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+
+    // PDU 하나가 한도를 넘을 수는 없으므로 경계를 잃은 것으로 보고 버림
+    if (stream.buffer.size() > m_config.max_stream_bytes) {
+        framing_error = true;
+        stream.buffer.clear();
+    }
+    return count;
+}
+
+// 보관해 둔 segment 중 이제 이어지는 것을 순서대로 붙임
+int TcpStreamReassembler::drainHeld(Stream& stream, TcpFraming framing, const PduHandler& handler,
+                                    bool& framing_error) {
+    int count = 0;
+    while (!stream.held.empty()) {
+        auto first = stream.held.begin();
+        int32_t ahead = static_cast<int32_t>(first->first - stream.next_seq);
+        if (ahead > 0) break;
+
+        std::vector<u_char> data = std::move(first->second);
+        stream.held_bytes -= data.size();
+        stream.held.erase(first);
+
+        size_t seen = static_cast<size_t>(-static_cast<int64_t>(ahead));
+        if (seen >= data.size()) continue;
+        count += deliver(stream, data.data() + seen, data.size() - seen, framing, handler, framing_error);
+    }
+    return count;
+}
+
+void TcpStreamReassembler::addStatsTo(TcpStreamStats& stats) const {
+    stats.segments += m_segments.load(std::memory_order_relaxed);
+    stats.pdus += m_pdus.load(std::memory_order_relaxed);
+    stats.buffered_pdus += m_buffered_pdus.load(std::memory_order_relaxed);
+    stats.retransmissions += m_retransmissions.load(std::memory_order_relaxed);
+    stats.overlaps += m_overlaps.load(std::memory_order_relaxed);
+    stats.out_of_order += m_out_of_order.load(std::memory_order_relaxed);
+    stats.gaps += m_gaps.load(std::memory_order_relaxed);
+    stats.framing_errors += m_framing_errors.load(std::memory_order_relaxed);
+    stats.evicted += m_evicted.load(std::memory_order_relaxed);
+    stats.streams += m_streams_snapshot.load(std::memory_order_relaxed);
+    stats.bytes_in_use += m_bytes_snapshot.load(std::memory_order_relaxed);
+}
+
+// 1초에 한 번만 테이블 전체를 훑음
+void TcpStreamReassembler::expire(time_t now) {
+    if (now == m_last_sweep) return;
+    m_last_sweep = now;
+
+    for (auto it = m_streams.begin(); it != m_streams.end();) {
+        if (now - it->second.last_seen >= m_config.timeout_sec) {
+            auto expired = it++;
+            erase(expired);
+            m_evicted.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// 가장 오래 조용했던 stream의 버퍼부터 버림 (keep은 마지막에 비움)
+void TcpStreamReassembler::makeRoom(const Key& keep) {
+    while (m_bytes_in_use > m_config.max_bytes) {
+        auto oldest = m_streams.end();
+        for (auto it = m_streams.begin(); it != m_streams.end(); ++it) {
+            if (it->second.bytes() == 0 || it->first == keep) continue;
+            if (oldest == m_streams.end() || it->second.last_seen < oldest->second.last_seen) {
+                oldest = it;
+            }
+        }
+        if (oldest == m_streams.end()) {
+            oldest = m_streams.find(keep);
+            if (oldest == m_streams.end()) return;
+        }
+        erase(oldest);
+        m_evicted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void TcpStreamReassembler::erase(StreamMap::iterator it) {
+    m_bytes_in_use -= it->second.bytes();
+    m_streams.erase(it);
+}
+
+void TcpStreamReassembler::updateSnapshot() {
+    m_streams_snapshot.store(m_streams.size(), std::memory_order_relaxed);
+    m_bytes_snapshot.store(m_bytes_in_use, std::memory_order_relaxed);
+}
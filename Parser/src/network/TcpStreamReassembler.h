@@ -0,0 +1,134 @@
+#ifndef TCP_STREAM_REASSEMBLER_H
+#define TCP_STREAM_REASSEMBLER_H
+
+#include <pcap.h>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "packet_info.h"
+
+// 길이 필드로 PDU 경계를 정하는 TCP 애플리케이션 프로토콜
+enum TcpFraming {
+    FRAMING_NONE = 0,
+    FRAMING_MBAP,   // Modbus/TCP: 6바이트 MBAP + length(unit id + PDU)
+    FRAMING_TPKT,   // S7comm (RFC 1006): 03 00 + 전체 길이
+    FRAMING_XGT     // XGT FEnet: "LSIS-XGT" 20바이트 헤더 + length(LE)
+};
+
+// protocols/* 파서의 포트와 맞춰야 함
+inline TcpFraming tcpFramingForPorts(uint16_t src_port, uint16_t dst_port) {
+    for (uint16_t port : {src_port, dst_port}) {
+        switch (port) {
+            case 502:  return FRAMING_MBAP;
+            case 102:  return FRAMING_TPKT;
+            case 2004: return FRAMING_XGT;
+            default:   break;
+        }
+    }
+    return FRAMING_NONE;
+}
+
+struct TcpStreamConfig {
+    size_t max_bytes = 8 * 1024 * 1024;   // 모든 stream의 버퍼 합계 한도 (PacketParser가 worker 수로 나눔, 0 = 재조립 끔)
+    size_t max_stream_bytes = 65536;      // stream 하나가 붙잡고 있을 수 있는 최대 바이트 (PDU보다 커야 함)
+    int max_out_of_order = 8;             // stream당 순서가 어긋나 보관하는 segment 수
+    int timeout_sec = 120;                // 이 시간(패킷 timestamp 기준) 동안 segment가 없으면 stream 폐기
+};
+
+// 재조립 결과 (worker들의 카운터를 합친 스냅샷)
+struct TcpStreamStats {
+    uint64_t segments = 0;          // stream에 들어온 payload segment
+    uint64_t pdus = 0;              // 파서로 넘긴 완성 PDU
+    uint64_t buffered_pdus = 0;     // 그중 여러 segment를 이어 붙여 만든 PDU
+    uint64_t retransmissions = 0;   // 이미 받은 데이터만 담긴 segment
+    uint64_t overlaps = 0;          // 앞부분이 겹쳐서 잘라낸 segment
+    uint64_t out_of_order = 0;      // 앞선 segment를 기다리며 보관한 segment
+    uint64_t gaps = 0;              // 빠진 데이터를 포기하고 건너뛴 횟수
+    uint64_t framing_errors = 0;    // 길이 헤더가 맞지 않아 버퍼를 버린 횟수
+    uint64_t evicted = 0;           // 메모리/stream 한도 또는 timeout으로 버린 stream
+    size_t streams = 0;
+    size_t bytes_in_use = 0;
+};
+
+// 방향별 TCP stream을 순서대로 이어 붙여 MBAP/TPKT/XGT PDU 단위로 잘라 주는 테이블
+// (worker 하나가 소유, lock 없음)
+// 버퍼에 남은 조각이 없고 segment 안에 PDU가 온전히 들어 있으면 패킷 버퍼를 그대로 넘기고,
+// segment 경계에 걸친 PDU만 stream 버퍼에 복사합니다.
+class TcpStreamReassembler {
+public:
+    using PduHandler = std::function<void(const u_char* pdu, int size)>;
+
+    explicit TcpStreamReassembler(const TcpStreamConfig& config = TcpStreamConfig());
+
+    void configure(const TcpStreamConfig& config) { m_config = config; }
+    bool enabled() const { return m_config.max_bytes > 0; }
+
+    // info는 decode된 TCP segment (payload = TCP payload)
+    // 완성된 PDU마다 handler를 호출하고 그 수를 반환
+    // payload가 없거나 framing이 맞지 않아 stream으로 처리하지 않은 segment는 -1 (호출한 쪽이 그대로 파싱)
+    int add(const PacketInfo& info, TcpFraming framing, const PduHandler& handler);
+
+    void addStatsTo(TcpStreamStats& stats) const;
+
+private:
+    // 양방향 공통 flow 키 + 방향 (reverse = src가 flow의 b쪽)
+    struct Key {
+        FlowKey flow;
+        bool reverse;
+
+        bool operator==(const Key& other) const { return reverse == other.reverse && flow == other.flow; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return key.flow.hash ^ static_cast<size_t>(key.reverse); }
+    };
+
+    struct Stream {
+        uint32_t next_seq = 0;                           // 다음에 이어 붙일 sequence
+        time_t last_seen = 0;
+        std::vector<u_char> buffer;                      // 아직 PDU가 되지 못한 앞부분
+        std::map<uint32_t, std::vector<u_char>> held;    // next_seq보다 앞선 segment (seq -> data)
+        size_t held_bytes = 0;
+
+        size_t bytes() const { return buffer.size() + held_bytes; }
+    };
+
+    using StreamMap = std::unordered_map<Key, Stream, KeyHash>;
+
+    TcpStreamConfig m_config;
+    StreamMap m_streams;
+    size_t m_bytes_in_use = 0;
+    time_t m_last_sweep = 0;
+
+    // 다른 스레드에서 통계만 읽음
+    std::atomic<uint64_t> m_segments{0};
+    std::atomic<uint64_t> m_pdus{0};
+    std::atomic<uint64_t> m_buffered_pdus{0};
+    std::atomic<uint64_t> m_retransmissions{0};
+    std::atomic<uint64_t> m_overlaps{0};
+    std::atomic<uint64_t> m_out_of_order{0};
+    std::atomic<uint64_t> m_gaps{0};
+    std::atomic<uint64_t> m_framing_errors{0};
+    std::atomic<uint64_t> m_evicted{0};
+    std::atomic<size_t> m_streams_snapshot{0};
+    std::atomic<size_t> m_bytes_snapshot{0};
+
+    int deliver(Stream& stream, const u_char* data, size_t size, TcpFraming framing,
+                const PduHandler& handler, bool& framing_error);
+    int drainHeld(Stream& stream, TcpFraming framing, const PduHandler& handler, bool& framing_error);
+    void expire(time_t now);
+    void makeRoom(const Key& keep);
+    void erase(StreamMap::iterator it);
+    void updateSnapshot();
+};
+
+// 버퍼 앞에서 PDU 하나의 전체 길이를 구함
+// 헤더가 아직 다 오지 않았으면 0, 헤더가 해당 프로토콜이 아니면 -1
+int tcpFrameLength(TcpFraming framing, const u_char* data, size_t size);
+
+#endif // TCP_STREAM_REASSEMBLER_H
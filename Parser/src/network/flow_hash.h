@@ -0,0 +1,154 @@
+#ifndef FLOW_HASH_H
+#define FLOW_HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include "network_headers.h"
+#include "link_layer.h"
+#include "ipv6.h"
+
+namespace flow_hash {
+
+inline uint32_t mix(uint32_t h, uint32_t v) {
+    h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+// murmur3 finalizer: 하위 비트까지 고르게 섞어서 worker 수로 나눠도 치우치지 않게 함
+inline uint32_t finalize(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+// 양방향이 같은 값이 되도록 두 endpoint를 정렬해서 섞음
+inline uint32_t endpoints(const uint8_t* addr_a, const uint8_t* addr_b, size_t addr_len,
+                          uint16_t port_a, uint16_t port_b, uint8_t proto) {
+    int cmp = memcmp(addr_a, addr_b, addr_len);
+    if (cmp > 0 || (cmp == 0 && port_a > port_b)) {
+        std::swap(addr_a, addr_b);
+        std::swap(port_a, port_b);
+    }
+
+    uint32_t h = proto;
+    for (size_t i = 0; i < addr_len; i += 4) {
+        uint32_t a, b;
+        memcpy(&a, addr_a + i, 4);
+        memcpy(&b, addr_b + i, 4);
+        h = mix(mix(h, a), b);
+    }
+    h = mix(h, (static_cast<uint32_t>(port_a) << 16) | port_b);
+    return finalize(h);
+}
+
+} // namespace flow_hash
+
+// 과부하 시 드롭 우선순위와 통계를 위한 트래픽 분류 (TRAFFIC_IT/OTHER가 low priority)
+enum TrafficClass : uint8_t {
+    TRAFFIC_ICS = 0,     // 등록된 ICS 프로토콜 포트 (Modbus, S7, XGT, DNP3, IEC 104, ...)
+    TRAFFIC_ARP,         // 자산 탐지에 필요
+    TRAFFIC_IT,          // DNS, DHCP
+    TRAFFIC_OTHER,
+    TRAFFIC_CLASS_COUNT
+};
+
+inline const char* trafficClassName(int traffic_class) {
+    static const char* names[TRAFFIC_CLASS_COUNT] = {"ics", "arp", "it", "other"};
+    return (traffic_class >= 0 && traffic_class < TRAFFIC_CLASS_COUNT) ? names[traffic_class] : "other";
+}
+
+inline bool isLowPriorityTraffic(uint8_t traffic_class) {
+    return traffic_class == TRAFFIC_IT || traffic_class == TRAFFIC_OTHER;
+}
+
+// 캡처 스레드에서 계산하는 패킷 요약
+struct FlowHint {
+    uint32_t hash = 0;                  // worker 배정용 양방향 대칭 hash
+    uint8_t traffic_class = TRAFFIC_OTHER;
+};
+
+namespace flow_hash {
+
+// protocols/* 파서가 처리하는 포트와 맞춰야 함
+inline uint8_t classifyPort(uint16_t port) {
+    switch (port) {
+        case 502: case 102: case 2004: case 20000:
+        case 2404: case 44818: case 4840: case 47808:
+            return TRAFFIC_ICS;
+        case 53: case 67: case 68:
+            return TRAFFIC_IT;
+        default:
+            return TRAFFIC_OTHER;
+    }
+}
+
+inline uint8_t classifyPorts(uint16_t port_a, uint16_t port_b) {
+    return std::min(classifyPort(port_a), classifyPort(port_b));
+}
+
+} // namespace flow_hash
+
+// worker 배정은 포트 없이 주소 쌍 + 프로토콜로 함 (kernel PACKET_FANOUT_HASH|FLAG_DEFRAG와 같은 기준)
+// IPv4 조각은 두 번째부터 포트가 없어서, 포트를 넣으면 조각과 조각 아닌 패킷이 서로 다른 worker로 가고
+// 재조립된 datagram이 그 flow의 Modbus/S7 요청 상태와 TCP stream 테이블이 없는 worker에서 파싱됨
+// IPv6는 non-first fragment에 최종 프로토콜도 없으므로 주소 쌍만 사용
+// 포트는 트래픽 분류(드롭 우선순위)에만 사용, IP가 아닌 패킷(ARP 등)은 hash 0
+inline FlowHint computeFlowHint(int datalink, const u_char* packet, uint32_t caplen) {
+    FlowHint hint;
+    LinkLayerInfo link;
+    if (!packet || !decodeLinkLayer(datalink, packet, caplen, link)) {
+        return hint;
+    }
+
+    if (link.eth_type == 0x0806) {
+        hint.traffic_class = TRAFFIC_ARP;
+        return hint;
+    }
+
+    const u_char* l3 = packet + link.l3_offset;
+    uint32_t l3_len = caplen - link.l3_offset;
+
+    if (link.eth_type == 0x0800) {
+        if (l3_len < sizeof(IPHeader)) return hint;
+        const IPHeader* ip = reinterpret_cast<const IPHeader*>(l3);
+        uint32_t ip_hl = ip->hl * 4;
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(&ip->ip_src);
+        const uint8_t* dst = reinterpret_cast<const uint8_t*>(&ip->ip_dst);
+
+        hint.hash = flow_hash::endpoints(src, dst, 4, 0, 0, ip->p);
+
+        bool fragment = (ntohs(ip->off) & 0x1fff) != 0;
+        if (!fragment && (ip->p == 6 || ip->p == 17) && l3_len >= ip_hl + 4) {
+            const uint16_t* ports = reinterpret_cast<const uint16_t*>(l3 + ip_hl);
+            hint.traffic_class = flow_hash::classifyPorts(ntohs(ports[0]), ntohs(ports[1]));
+        }
+        return hint;
+    }
+
+    if (link.eth_type == 0x86DD) {
+        ipv6::L4Location loc;
+        if (!ipv6::locateL4(l3, l3_len, loc)) return hint;
+        const uint8_t* src = l3 + 8;
+        const uint8_t* dst = l3 + 24;
+        hint.hash = flow_hash::endpoints(src, dst, 16, 0, 0, 0);
+
+        if ((loc.protocol == 6 || loc.protocol == 17) && loc.l4_size >= 4) {
+            const uint16_t* ports = reinterpret_cast<const uint16_t*>(l3 + loc.l4_offset);
+            hint.traffic_class = flow_hash::classifyPorts(ntohs(ports[0]), ntohs(ports[1]));
+        }
+        return hint;
+    }
+
+    return hint;
+}
+
+inline uint32_t computeFlowHash(int datalink, const u_char* packet, uint32_t caplen) {
+    return computeFlowHint(datalink, packet, caplen).hash;
+}
+
+#endif // FLOW_HASH_H
@@ -0,0 +1,77 @@
+#ifndef FLOW_KEY_H
+#define FLOW_KEY_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "ip_address.h"
+#include "flow_hash.h"
+
+// 양방향이 같은 값이 되는 5-tuple + VLAN (작은 endpoint가 a)
+// 고정 길이 바이너리라 비교는 memcmp, hash는 만들 때 한 번만 계산
+// 문자열(toString)은 레코드에 필요할 때만 만듭니다.
+struct FlowKey {
+    uint32_t hash;
+    uint8_t addr_a[16];
+    uint8_t addr_b[16];
+    uint16_t port_a;
+    uint16_t port_b;
+    uint16_t vlan_ids[2];
+    uint8_t family;      // 4, 6 (0 = IP 아님)
+    uint8_t protocol;
+    uint8_t reserved[2];
+
+    // swapped가 있으면 src가 b쪽으로 갔는지 알려 줌 (방향별 상태를 구분할 때 사용)
+    static FlowKey make(const IpAddress& src_ip, uint16_t src_port, const IpAddress& dst_ip, uint16_t dst_port,
+                        uint8_t protocol, const uint16_t* vlan_ids, bool* swapped = nullptr) {
+        FlowKey key;
+        std::memset(&key, 0, sizeof(key));   // padding까지 0이어야 memcmp 비교가 맞음
+
+        bool swap = dst_ip < src_ip || (src_ip == dst_ip && src_port > dst_port);
+        const IpAddress& a = swap ? dst_ip : src_ip;
+        const IpAddress& b = swap ? src_ip : dst_ip;
+        std::memcpy(key.addr_a, a.bytes, a.length());
+        std::memcpy(key.addr_b, b.bytes, b.length());
+        key.port_a = swap ? dst_port : src_port;
+        key.port_b = swap ? src_port : dst_port;
+        key.vlan_ids[0] = vlan_ids[0];
+        key.vlan_ids[1] = vlan_ids[1];
+        key.family = src_ip.family;
+        key.protocol = protocol;
+        if (swapped) *swapped = swap;
+
+        // worker 배정 hash와 같은 방식으로 섞고 VLAN이 있으면 한 번 더 섞음
+        size_t addr_len = a.length() ? a.length() : 4;
+        key.hash = flow_hash::endpoints(key.addr_a, key.addr_b, addr_len, key.port_a, key.port_b, protocol);
+        if (vlan_ids[0] != 0 || vlan_ids[1] != 0) {
+            key.hash = flow_hash::finalize(flow_hash::mix(key.hash, (static_cast<uint32_t>(vlan_ids[0]) << 16) | vlan_ids[1]));
+        }
+        return key;
+    }
+
+    bool operator==(const FlowKey& other) const { return std::memcmp(this, &other, sizeof(FlowKey)) == 0; }
+    bool operator!=(const FlowKey& other) const { return !(*this == other); }
+    bool operator<(const FlowKey& other) const { return std::memcmp(this, &other, sizeof(FlowKey)) < 0; }
+
+    IpAddress addressA() const { return family == 6 ? IpAddress::v6(addr_a) : IpAddress::v4(addr_a); }
+    IpAddress addressB() const { return family == 6 ? IpAddress::v6(addr_b) : IpAddress::v4(addr_b); }
+
+    // "ip:port-ip:port", VLAN이 있으면 "@10" 또는 "@100.10"
+    std::string toString() const {
+        std::string id = addressA().toString() + ":" + std::to_string(port_a) + "-" +
+                         addressB().toString() + ":" + std::to_string(port_b);
+        if (vlan_ids[0] != 0) {
+            id += "@" + std::to_string(vlan_ids[0]);
+            if (vlan_ids[1] != 0) id += "." + std::to_string(vlan_ids[1]);
+        }
+        return id;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 48, "FlowKey must stay a padding-free 48-byte key");
+
+struct FlowKeyHash {
+    size_t operator()(const FlowKey& key) const { return key.hash; }
+};
+
+#endif // FLOW_KEY_H
@@ -0,0 +1,84 @@
+#ifndef IP_ADDRESS_H
+#define IP_ADDRESS_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "packet_format.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#endif
+
+// IPv4/IPv6 주소 (network byte order 그대로, 문자열 변환은 출력할 때만)
+struct IpAddress {
+    uint8_t family = 0;       // 0 = 없음 (ARP 등), 4, 6
+    uint8_t bytes[16] = {};   // IPv4는 앞 4바이트만 사용
+
+    static IpAddress v4(const void* addr) {
+        IpAddress ip;
+        ip.family = 4;
+        std::memcpy(ip.bytes, addr, 4);
+        return ip;
+    }
+
+    static IpAddress v6(const void* addr) {
+        IpAddress ip;
+        ip.family = 6;
+        std::memcpy(ip.bytes, addr, 16);
+        return ip;
+    }
+
+    // "192.168.0.1" 또는 "fe80::1" 텍스트를 파싱 (설정/CSV 입력용)
+    static bool parse(const std::string& text, IpAddress& out) {
+        IpAddress ip;
+        if (inet_pton(AF_INET, text.c_str(), ip.bytes) == 1) {
+            ip.family = 4;
+        } else if (inet_pton(AF_INET6, text.c_str(), ip.bytes) == 1) {
+            ip.family = 6;
+        } else {
+            return false;
+        }
+        out = ip;
+        return true;
+    }
+
+    bool empty() const { return family == 0; }
+    bool isV4() const { return family == 4; }
+    bool isV6() const { return family == 6; }
+
+    size_t length() const { return family == 6 ? 16 : (family == 4 ? 4 : 0); }
+
+    // host byte order (IPv4 전용)
+    uint32_t v4Value() const {
+        return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+               (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+    }
+
+    std::string toString() const {
+        if (family == 4) {
+            return packet_format::ipv4(bytes);
+        } else if (family == 6) {
+            // IPv6는 0 구간 압축 규칙 때문에 inet_ntop 사용 (ICS 트래픽에서는 드묾)
+            char buf[INET6_ADDRSTRLEN];
+            inet_ntop(AF_INET6, bytes, buf, sizeof(buf));
+            return std::string(buf);
+        }
+        return std::string();
+    }
+
+    bool operator==(const IpAddress& other) const {
+        return family == other.family && std::memcmp(bytes, other.bytes, length()) == 0;
+    }
+    bool operator!=(const IpAddress& other) const { return !(*this == other); }
+
+    bool operator<(const IpAddress& other) const {
+        if (family != other.family) return family < other.family;
+        return std::memcmp(bytes, other.bytes, length()) < 0;
+    }
+};
+
+#endif // IP_ADDRESS_H
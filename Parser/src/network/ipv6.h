@@ -0,0 +1,85 @@
+#ifndef IPV6_H
+#define IPV6_H
+
+#include <cstdint>
+#include "network_headers.h"
+
+// IPv6 확장 헤더 체인 처리 (packet_decoder와 flow_hash가 같은 규칙을 써야 worker 배정과 파싱이 일치함)
+namespace ipv6 {
+
+// 정상 패킷은 2~3개면 충분, 악의적으로 긴 체인에 시간을 쓰지 않도록 제한
+static const int MAX_EXTENSION_HEADERS = 8;
+
+static const uint8_t NH_HOP_BY_HOP = 0;
+static const uint8_t NH_ROUTING = 43;
+static const uint8_t NH_FRAGMENT = 44;
+static const uint8_t NH_AH = 51;
+static const uint8_t NH_DEST_OPTIONS = 60;
+static const uint8_t NH_MOBILITY = 135;
+
+struct L4Location {
+    uint8_t protocol;      // 체인 끝의 next header (non-first fragment면 NH_FRAGMENT)
+    uint32_t l4_offset;    // L3 시작부터 L4 헤더까지
+    uint32_t l4_size;      // payload_len 기준 L4 길이
+    bool fragmented;       // Fragment 헤더가 있음 (첫 조각 포함)
+};
+
+// 기본 헤더 뒤의 확장 헤더를 건너뛰어 L4 위치를 구함
+// 체인이 잘렸거나 MAX_EXTENSION_HEADERS를 넘으면 false
+// 첫 조각(offset 0)은 L4 헤더가 있으므로 계속 진행, 이후 조각은 protocol을 NH_FRAGMENT로 남김
+inline bool locateL4(const uint8_t* l3, uint32_t l3_len, L4Location& out) {
+    if (l3_len < sizeof(IPv6Header)) return false;
+    const IPv6Header* ip6 = reinterpret_cast<const IPv6Header*>(l3);
+
+    uint32_t end = static_cast<uint32_t>(sizeof(IPv6Header)) + ntohs(ip6->payload_len);
+    if (ip6->payload_len == 0 || end > l3_len) {
+        end = l3_len;  // jumbogram 또는 snaplen으로 잘린 패킷
+    }
+
+    out.fragmented = false;
+    uint8_t next = ip6->next_header;
+    uint32_t offset = sizeof(IPv6Header);
+    for (int i = 0; i <= MAX_EXTENSION_HEADERS; ++i) {
+        uint32_t ext_len;
+        switch (next) {
+            case NH_HOP_BY_HOP:
+            case NH_ROUTING:
+            case NH_DEST_OPTIONS:
+            case NH_MOBILITY:
+                if (offset + 2 > end) return false;
+                ext_len = (static_cast<uint32_t>(l3[offset + 1]) + 1) * 8;
+                break;
+            case NH_AH:
+                if (offset + 2 > end) return false;
+                ext_len = (static_cast<uint32_t>(l3[offset + 1]) + 2) * 4;
+                break;
+            case NH_FRAGMENT: {
+                if (offset + 8 > end) return false;
+                out.fragmented = true;
+                uint16_t frag_off = static_cast<uint16_t>(((l3[offset + 2] << 8) | l3[offset + 3]) & 0xFFF8);
+                if (frag_off != 0) {
+                    out.protocol = NH_FRAGMENT;
+                    out.l4_offset = offset;
+                    out.l4_size = end - offset;
+                    return true;
+                }
+                ext_len = 8;
+                break;
+            }
+            default:
+                // TCP/UDP/ICMPv6/ESP/No Next Header 등 확장 헤더가 아닌 것
+                out.protocol = next;
+                out.l4_offset = offset;
+                out.l4_size = end - offset;
+                return true;
+        }
+        if (offset + ext_len > end) return false;
+        next = l3[offset];
+        offset += ext_len;
+    }
+    return false;
+}
+
+} // namespace ipv6
+
+#endif // IPV6_H
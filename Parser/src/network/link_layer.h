@@ -0,0 +1,159 @@
+#ifndef LINK_LAYER_H
+#define LINK_LAYER_H
+
+#include <pcap.h>
+#include <cstdint>
+#include <cstring>
+#include "network_headers.h"
+
+// 링크 계층 디코딩 결과 (패킷 버퍼를 그대로 가리킴, 복사 없음)
+struct LinkLayerInfo {
+    const uint8_t* src_mac;   // MAC이 없는 링크 타입은 zero MAC
+    const uint8_t* dst_mac;
+    uint16_t eth_type;        // host byte order (raw IP/loopback은 IP 버전으로 결정)
+    uint32_t l3_offset;       // 패킷 시작부터 L3 헤더까지의 오프셋 (VLAN 태그 포함)
+    uint16_t vlan_ids[2];     // 바깥쪽 태그부터 (QinQ면 [0]=S-VLAN, [1]=C-VLAN)
+    uint8_t vlan_count;       // VID가 0인 priority 태그는 세지 않음
+};
+
+#pragma pack(push, 1)
+
+// Linux cooked capture v1 (DLT_LINUX_SLL, 16 bytes)
+struct SllHeader {
+    uint16_t pkttype;
+    uint16_t hatype;
+    uint16_t halen;
+    uint8_t  addr[8];
+    uint16_t protocol;
+};
+
+// Linux cooked capture v2 (DLT_LINUX_SLL2, 20 bytes)
+struct Sll2Header {
+    uint16_t protocol;
+    uint16_t reserved;
+    uint32_t ifindex;
+    uint16_t hatype;
+    uint8_t  pkttype;
+    uint8_t  halen;
+    uint8_t  addr[8];
+};
+
+#pragma pack(pop)
+
+namespace link_layer {
+
+static const uint8_t ZERO_MAC[6] = {0, 0, 0, 0, 0, 0};
+
+// 802.1Q, 802.1ad(QinQ), 구형 QinQ 장비의 0x9100
+inline bool isVlanTpid(uint16_t eth_type) {
+    return eth_type == 0x8100 || eth_type == 0x88A8 || eth_type == 0x9100;
+}
+
+// 최대 태그 수 (QinQ 2단 + priority 태그 여유)
+static const int MAX_VLAN_TAGS = 3;
+
+// L2 헤더 뒤의 VLAN 태그(4 bytes: TCI + 다음 eth_type)를 건너뛰고 안쪽 eth_type을 구함
+// 태그 수가 MAX_VLAN_TAGS를 넘으면 eth_type이 TPID로 남아 IP로 처리되지 않음
+inline bool skipVlanTags(const u_char* packet, uint32_t caplen, LinkLayerInfo& out) {
+    for (int i = 0; i < MAX_VLAN_TAGS && isVlanTpid(out.eth_type); ++i) {
+        if (caplen < out.l3_offset + 4) return false;
+        const u_char* tag = packet + out.l3_offset;
+        uint16_t vid = static_cast<uint16_t>(((tag[0] << 8) | tag[1]) & 0x0FFF);
+        if (vid != 0 && out.vlan_count < 2) {
+            out.vlan_ids[out.vlan_count++] = vid;
+        }
+        out.eth_type = static_cast<uint16_t>((tag[2] << 8) | tag[3]);
+        out.l3_offset += 4;
+    }
+    return true;
+}
+
+// SLL 주소는 캡처한 쪽(송신자) 하나만 있음
+inline void setCookedAddress(LinkLayerInfo& out, const uint8_t* addr, unsigned halen) {
+    out.src_mac = (halen == 6) ? addr : ZERO_MAC;
+    out.dst_mac = ZERO_MAC;
+}
+
+// raw IP: 첫 nibble로 IPv4/IPv6 구분
+inline bool decodeRawIp(const u_char* packet, uint32_t caplen, uint32_t offset, LinkLayerInfo& out) {
+    if (caplen <= offset) return false;
+    uint8_t version = packet[offset] >> 4;
+    if (version == 4) {
+        out.eth_type = 0x0800;
+    } else if (version == 6) {
+        out.eth_type = 0x86DD;
+    } else {
+        return false;
+    }
+    out.src_mac = ZERO_MAC;
+    out.dst_mac = ZERO_MAC;
+    out.l3_offset = offset;
+    return true;
+}
+
+} // namespace link_layer
+
+// 지원하는 링크 타입인지 (pcap_datalink() 값)
+inline bool isSupportedDatalink(int datalink) {
+    switch (datalink) {
+        case DLT_EN10MB:
+        case DLT_LINUX_SLL:
+        case DLT_LINUX_SLL2:
+        case DLT_RAW:
+        case DLT_IPV4:
+        case DLT_IPV6:
+        case DLT_NULL:
+        case DLT_LOOP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// pcap_datalink() 값에 따라 L2 헤더를 해석해서 공통 L3 오프셋을 구함
+inline bool decodeLinkLayer(int datalink, const u_char* packet, uint32_t caplen, LinkLayerInfo& out) {
+    out.vlan_ids[0] = 0;
+    out.vlan_ids[1] = 0;
+    out.vlan_count = 0;
+    switch (datalink) {
+        case DLT_EN10MB: {
+            if (caplen < sizeof(EthernetHeader)) return false;
+            const EthernetHeader* eth = reinterpret_cast<const EthernetHeader*>(packet);
+            out.src_mac = eth->src_mac;
+            out.dst_mac = eth->dest_mac;
+            out.eth_type = ntohs(eth->eth_type);
+            out.l3_offset = sizeof(EthernetHeader);
+            return link_layer::skipVlanTags(packet, caplen, out);
+        }
+        case DLT_LINUX_SLL: {
+            if (caplen < sizeof(SllHeader)) return false;
+            const SllHeader* sll = reinterpret_cast<const SllHeader*>(packet);
+            link_layer::setCookedAddress(out, sll->addr, ntohs(sll->halen));
+            out.eth_type = ntohs(sll->protocol);
+            out.l3_offset = sizeof(SllHeader);
+            return link_layer::skipVlanTags(packet, caplen, out);
+        }
+        case DLT_LINUX_SLL2: {
+            if (caplen < sizeof(Sll2Header)) return false;
+            const Sll2Header* sll2 = reinterpret_cast<const Sll2Header*>(packet);
+            link_layer::setCookedAddress(out, sll2->addr, sll2->halen);
+            out.eth_type = ntohs(sll2->protocol);
+            out.l3_offset = sizeof(Sll2Header);
+            return link_layer::skipVlanTags(packet, caplen, out);
+        }
+        case DLT_RAW:
+        case DLT_IPV4:
+        case DLT_IPV6:
+            return link_layer::decodeRawIp(packet, caplen, 0, out);
+        case DLT_NULL:
+        case DLT_LOOP: {
+            // 4바이트 address family (NULL은 캡처 호스트 byte order, LOOP는 network order)
+            if (caplen < 4) return false;
+            return link_layer::decodeRawIp(packet, caplen, 4, out);
+        }
+        default:
+            return false;
+    }
+}
+
+#endif // LINK_LAYER_H
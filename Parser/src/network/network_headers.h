@@ -36,6 +36,16 @@ struct IPHeader {
     struct   in_addr ip_src, ip_dst; // Source and Destination Address
 };
 
+// IPv6 Header (40 bytes, 확장 헤더는 next_header 체인으로 이어짐)
+struct IPv6Header {
+    uint32_t vtc_flow;       // Version(4) + Traffic Class(8) + Flow Label(20)
+    uint16_t payload_len;    // 기본 헤더 뒤의 길이 (확장 헤더 포함, 0이면 jumbogram)
+    uint8_t  next_header;
+    uint8_t  hop_limit;
+    uint8_t  ip6_src[16];
+    uint8_t  ip6_dst[16];
+};
+
 // TCP Header (20 bytes minimum)
 struct TCPHeader {
     uint16_t sport;     // Source Port
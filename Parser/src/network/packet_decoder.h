@@ -0,0 +1,124 @@
+#ifndef PACKET_DECODER_H
+#define PACKET_DECODER_H
+
+#include <pcap.h>
+#include <cstdint>
+#include <cstring>
+#include "network_headers.h"
+#include "link_layer.h"
+#include "ipv6.h"
+#include "packet_info.h"
+
+enum DecodeResult {
+    DECODE_OK = 0,            // info가 채워짐 (L4가 TCP/UDP가 아니면 포트 등은 0)
+    DECODE_UNSUPPORTED_LINK,  // 링크 타입을 모르거나 L2 헤더가 잘림
+    DECODE_TRUNCATED,         // L3/L4 헤더가 캡처 길이보다 짧음
+    DECODE_FRAGMENT           // IPv4 조각: L3 필드만 채움 (재조립 후 다시 decode)
+};
+
+namespace packet_decoder {
+
+// L2 -> L4 (IPv4, IPv6 + 확장 헤더)를 한 번에 디코딩해서 고정 길이 필드만 채움 (문자열/힙 할당 없음)
+// payload는 ARP면 L3 시작, TCP/UDP면 L7 시작을 가리킴
+inline DecodeResult decode(int datalink, const struct pcap_pkthdr* header, const u_char* packet,
+                           bool nano, PacketInfo& info) {
+    LinkLayerInfo link;
+    if (!decodeLinkLayer(datalink, packet, header->caplen, link)) {
+        return DECODE_UNSUPPORTED_LINK;
+    }
+
+    info.ts = header->ts;
+    info.nano_ts = nano;
+    info.ts_ns = packet_format::toNanoseconds(header->ts, nano);
+    std::memcpy(info.src_mac, link.src_mac, 6);
+    std::memcpy(info.dst_mac, link.dst_mac, 6);
+    info.eth_type = link.eth_type;
+    info.vlan_ids[0] = link.vlan_ids[0];
+    info.vlan_ids[1] = link.vlan_ids[1];
+    info.vlan_count = link.vlan_count;
+    info.l3_offset = static_cast<uint16_t>(link.l3_offset);
+
+    const u_char* l3 = packet + link.l3_offset;
+    int l3_size = static_cast<int>(header->caplen - link.l3_offset);
+
+    const u_char* l4;
+    int l4_size;
+    if (link.eth_type == 0x0800) {
+        if (static_cast<size_t>(l3_size) < sizeof(IPHeader)) return DECODE_TRUNCATED;
+
+        const IPHeader* ip_header = reinterpret_cast<const IPHeader*>(l3);
+        int ip_header_len = ip_header->hl * 4;
+        if (ip_header->hl < 5 || ip_header_len > l3_size) return DECODE_TRUNCATED;
+
+        info.src_ip = IpAddress::v4(&ip_header->ip_src);
+        info.dst_ip = IpAddress::v4(&ip_header->ip_dst);
+        info.protocol = ip_header->p;
+
+        // MF 또는 offset이 있으면 조각이므로 L4 헤더를 읽지 않음 (두 번째 조각부터는 TCP/UDP 헤더가 없음)
+        if ((ntohs(ip_header->off) & 0x3fff) != 0) {
+            info.payload = l3;
+            info.payload_size = l3_size;
+            return DECODE_FRAGMENT;
+        }
+
+        // IP Total Length 기준 (ACK 뒤의 패딩이 payload로 잡히지 않도록)
+        // 단, snaplen으로 잘렸거나 길이가 위조된 패킷은 캡처된 바이트를 넘지 않게 자름
+        int ip_total_len = ntohs(ip_header->len);
+        if (ip_total_len > l3_size) ip_total_len = l3_size;
+        if (ip_total_len < ip_header_len) return DECODE_TRUNCATED;
+        l4_size = ip_total_len - ip_header_len;
+        l4 = l3 + ip_header_len;
+        info.l4_offset = static_cast<uint16_t>(info.l3_offset + ip_header_len);
+    } else if (link.eth_type == 0x86DD) {
+        // 확장 헤더를 건너뛴 뒤의 TCP/UDP를 IPv4와 같은 경로로 디코딩
+        ipv6::L4Location loc;
+        if (!ipv6::locateL4(l3, static_cast<uint32_t>(l3_size), loc)) return DECODE_TRUNCATED;
+
+        const IPv6Header* ip6_header = reinterpret_cast<const IPv6Header*>(l3);
+        info.src_ip = IpAddress::v6(ip6_header->ip6_src);
+        info.dst_ip = IpAddress::v6(ip6_header->ip6_dst);
+        info.protocol = loc.protocol;
+
+        l4_size = static_cast<int>(loc.l4_size);
+        l4 = l3 + loc.l4_offset;
+        info.l4_offset = static_cast<uint16_t>(info.l3_offset + loc.l4_offset);
+    } else {
+        info.payload = l3;
+        info.payload_size = l3_size;
+        return DECODE_OK;
+    }
+
+    if (info.protocol == IPPROTO_TCP) {
+        if (l4_size < static_cast<int>(sizeof(TCPHeader))) return DECODE_TRUNCATED;
+
+        const TCPHeader* tcp_header = reinterpret_cast<const TCPHeader*>(l4);
+        int tcp_header_len = tcp_header->off * 4;
+        if (tcp_header->off < 5 || tcp_header_len > l4_size) return DECODE_TRUNCATED;
+
+        info.src_port = ntohs(tcp_header->sport);
+        info.dst_port = ntohs(tcp_header->dport);
+        info.tcp_seq = ntohl(tcp_header->seq);
+        info.tcp_ack = ntohl(tcp_header->ack);
+        info.tcp_flags = tcp_header->flags;
+        info.l7_offset = static_cast<uint16_t>(info.l4_offset + tcp_header_len);
+        info.payload = l4 + tcp_header_len;
+        info.payload_size = l4_size - tcp_header_len;
+    } else if (info.protocol == IPPROTO_UDP) {
+        if (l4_size < static_cast<int>(sizeof(UDPHeader))) return DECODE_TRUNCATED;
+
+        const UDPHeader* udp_header = reinterpret_cast<const UDPHeader*>(l4);
+        info.src_port = ntohs(udp_header->sport);
+        info.dst_port = ntohs(udp_header->dport);
+        info.l7_offset = static_cast<uint16_t>(info.l4_offset + sizeof(UDPHeader));
+        info.payload = l4 + sizeof(UDPHeader);
+        info.payload_size = l4_size - static_cast<int>(sizeof(UDPHeader));
+    } else {
+        info.payload = l4;
+        info.payload_size = l4_size;
+    }
+    return DECODE_OK;
+}
+
+} // namespace packet_decoder
+
+#endif // PACKET_DECODER_H
@@ -0,0 +1,148 @@
+#ifndef PACKET_FORMAT_H
+#define PACKET_FORMAT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <winsock2.h>
+#endif
+
+// 디코딩된 고정 길이 필드의 문자열 변환 (레코드를 만들 때만 호출)
+namespace packet_format {
+
+// 바이트 -> 10진수 텍스트 표 ("0" ~ "255", 길이)
+struct DecimalTable {
+    char text[256][3];
+    uint8_t length[256];
+
+    constexpr DecimalTable() : text(), length() {
+        for (int i = 0; i < 256; i++) {
+            int n = 0;
+            if (i >= 100) text[i][n++] = static_cast<char>('0' + i / 100);
+            if (i >= 10) text[i][n++] = static_cast<char>('0' + i / 10 % 10);
+            text[i][n++] = static_cast<char>('0' + i % 10);
+            length[i] = static_cast<uint8_t>(n);
+        }
+    }
+};
+
+inline constexpr DecimalTable DECIMAL_TABLE{};
+inline constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+// "aa:bb:cc:dd:ee:ff" 17바이트 (NUL 없음), out은 18바이트 이상 (마지막 ':'까지 씀)
+inline void writeMac(const uint8_t* addr, char* out) {
+    for (int i = 0; i < 6; i++) {
+        out[i * 3] = HEX_DIGITS[addr[i] >> 4];
+        out[i * 3 + 1] = HEX_DIGITS[addr[i] & 0x0f];
+        out[i * 3 + 2] = ':';
+    }
+}
+
+// "192.168.0.1" 최대 15바이트 (NUL 없음), out은 16바이트 이상, 쓴 길이를 반환
+inline size_t writeIpv4(const uint8_t* addr, char* out) {
+    size_t n = 0;
+    for (int i = 0; i < 4; i++) {
+        // 표의 3바이트를 통째로 복사하고 길이만큼만 전진
+        std::memcpy(out + n, DECIMAL_TABLE.text[addr[i]], 3);
+        n += DECIMAL_TABLE.length[addr[i]];
+        out[n] = '.';
+        n += (i < 3);
+    }
+    return n;
+}
+
+// "aa:bb:cc:dd:ee:ff"
+inline std::string mac(const uint8_t* addr) {
+    char buf[18];
+    writeMac(addr, buf);
+    return std::string(buf, 17);
+}
+
+// "192.168.0.1"
+inline std::string ipv4(const uint8_t* addr) {
+    char buf[sizeof "255.255.255.255"];
+    return std::string(buf, writeIpv4(addr, buf));
+}
+
+// pcap timestamp -> epoch 나노초 (nano가 true면 ts.tv_usec에 나노초가 들어 있음, PCAP_TSTAMP_PRECISION_NANO)
+inline int64_t toNanoseconds(const struct timeval& ts, bool nano) {
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + static_cast<int64_t>(ts.tv_usec) * (nano ? 1 : 1000);
+}
+
+// epoch 초 -> UTC 날짜/시각 (gmtime 없이 정수 연산, days_from_civil의 역변환)
+struct UtcTime {
+    int year;
+    int month;    // 1-12
+    int day;      // 1-31
+    int hour;
+    int minute;
+    int second;
+};
+
+inline UtcTime utcTime(int64_t sec) {
+    int64_t days = sec / 86400;
+    int64_t rem = sec % 86400;
+    if (rem < 0) {
+        rem += 86400;
+        days--;
+    }
+
+    days += 719468;   // 0000-03-01 기준
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+
+    UtcTime t;
+    t.day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    t.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    t.year = static_cast<int>(yoe + era * 400 + (t.month <= 2 ? 1 : 0));
+    t.hour = static_cast<int>(rem / 3600);
+    t.minute = static_cast<int>(rem % 3600 / 60);
+    t.second = static_cast<int>(rem % 60);
+    return t;
+}
+
+// ISO 8601 UTC, nano면 소수점 9자리 아니면 6자리
+// "YYYY-MM-DDTHH:MM:SS" 부분은 스레드별로 캐시해서 초가 바뀔 때만 다시 만듦
+inline std::string timestamp(int64_t ts_ns, bool nano) {
+    static thread_local int64_t cached_sec = INT64_MIN;
+    static thread_local char prefix[sizeof "2011-10-08T07:07:09"];
+
+    int64_t sec = ts_ns / 1000000000LL;
+    int64_t frac = ts_ns % 1000000000LL;
+    if (frac < 0) {
+        frac += 1000000000LL;
+        sec--;
+    }
+
+    if (sec != cached_sec) {
+        UtcTime t = utcTime(sec);
+        std::snprintf(prefix, sizeof prefix, "%04d-%02d-%02dT%02d:%02d:%02d",
+                      t.year, t.month, t.day, t.hour, t.minute, t.second);
+        cached_sec = sec;
+    }
+
+    char buf[sizeof "2011-10-08T07:07:09.000000000Z"];
+    std::memcpy(buf, prefix, sizeof prefix - 1);
+    int digits = nano ? 9 : 6;
+    uint32_t value = static_cast<uint32_t>(nano ? frac : frac / 1000);
+    char* p = buf + sizeof prefix - 1;
+    *p++ = '.';
+    for (int i = digits - 1; i >= 0; i--) {
+        p[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    p += digits;
+    *p++ = 'Z';
+    return std::string(buf, static_cast<size_t>(p - buf));
+}
+
+} // namespace packet_format
+
+#endif // PACKET_FORMAT_H
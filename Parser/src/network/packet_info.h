@@ -0,0 +1,55 @@
+#ifndef PACKET_INFO_H
+#define PACKET_INFO_H
+
+#include <cstdint>
+#include <string>
+#include "ip_address.h"
+#include "flow_key.h"
+#include "packet_format.h"
+
+// Packet information structure
+// L2-L4 디코더가 한 번에 채우는 고정 길이 필드 (문자열 없음, payload는 패킷 버퍼를 그대로 가리킴)
+// 텍스트가 필요한 파서/레코드만 *String() 접근자로 변환합니다.
+struct PacketInfo {
+    struct timeval ts = {0, 0};
+    bool nano_ts = false;             // true면 ts.tv_usec에 나노초
+    int64_t ts_ns = 0;                // epoch 나노초 (레코드 정렬/시간 슬롯 계산용)
+    uint8_t src_mac[6] = {};
+    uint8_t dst_mac[6] = {};
+    uint16_t eth_type = 0;            // VLAN 태그 안쪽의 eth_type
+    uint16_t vlan_ids[2] = {};        // 바깥쪽 태그부터 (태그 없으면 0)
+    uint8_t vlan_count = 0;
+    IpAddress src_ip;
+    uint16_t src_port = 0;
+    IpAddress dst_ip;
+    uint16_t dst_port = 0;
+    uint8_t protocol = 0;
+    uint32_t tcp_seq = 0;
+    uint32_t tcp_ack = 0;
+    uint8_t tcp_flags = 0;
+    uint16_t l3_offset = 0;           // 패킷 시작부터 각 헤더까지 (해당 계층이 없으면 0)
+    uint16_t l4_offset = 0;
+    uint16_t l7_offset = 0;
+    const unsigned char* payload = nullptr;
+    int payload_size = 0;
+
+    std::string timestampString() const { return packet_format::timestamp(ts_ns, nano_ts); }
+    std::string srcMacString() const { return packet_format::mac(src_mac); }
+    std::string dstMacString() const { return packet_format::mac(dst_mac); }
+    std::string srcIpString() const { return src_ip.toString(); }
+    std::string dstIpString() const { return dst_ip.toString(); }
+
+    // "10", QinQ는 "100.10" (바깥쪽.안쪽), 태그 없으면 빈 문자열
+    std::string vlanString() const {
+        if (vlan_count == 0) return std::string();
+        if (vlan_count == 1) return std::to_string(vlan_ids[0]);
+        return std::to_string(vlan_ids[0]) + "." + std::to_string(vlan_ids[1]);
+    }
+
+    // 파서의 flow별 상태 키 (VLAN이 다르면 같은 IP 쌍이라도 다른 flow)
+    FlowKey flowKey(bool* swapped = nullptr) const {
+        return FlowKey::make(src_ip, src_port, dst_ip, dst_port, protocol, vlan_ids, swapped);
+    }
+};
+
+#endif // PACKET_INFO_H
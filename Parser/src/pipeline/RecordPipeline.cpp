@@ -0,0 +1,356 @@
+#include "RecordPipeline.h"
+#include "../ThreadPlacement.h"
+#include <iostream>
+#include <sstream>
+#include <chrono>
+
+namespace {
+
+const char* STAGE_NAMES[STAGE_COUNT] = {"enrich", "serialize", "sink"};
+
+uint64_t elapsedNs(std::chrono::steady_clock::time_point since) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - since).count());
+}
+
+} // namespace
+
+const char* pipelineStageName(int stage) {
+    return (stage >= 0 && stage < STAGE_COUNT) ? STAGE_NAMES[stage] : "unknown";
+}
+
+bool PipelineConfig::parse(const std::string& spec) {
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) continue;
+
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << "[ERROR] Pipeline stage must look like stage=threads: " << item << std::endl;
+            return false;
+        }
+
+        std::string name = item.substr(0, eq);
+        int stage = -1;
+        for (int i = 0; i < STAGE_COUNT; ++i) {
+            if (name == STAGE_NAMES[i]) stage = i;
+        }
+        if (stage < 0) {
+            std::cerr << "[ERROR] Unknown pipeline stage: " << name
+                      << " (expected enrich, serialize or sink)" << std::endl;
+            return false;
+        }
+
+        try {
+            int count = std::stoi(item.substr(eq + 1));
+            if (count < 0 || count > 16) throw std::out_of_range("threads");
+            threads[stage] = count;
+        } catch (const std::exception&) {
+            std::cerr << "[ERROR] Invalid thread count for pipeline stage " << name << ": "
+                      << item.substr(eq + 1) << " (0-16)" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string PipelineConfig::describe() const {
+    std::ostringstream out;
+    out << "decode(workers)";
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        out << " -> " << STAGE_NAMES[stage] << "(";
+        if (threads[stage] > 0) {
+            out << threads[stage];
+        } else {
+            out << "inline";
+        }
+        out << ")";
+    }
+    out << ", batch " << batch_size << ", queue " << queue_batches << " batches";
+    return out.str();
+}
+
+RecordPipeline::RecordPipeline() {}
+
+RecordPipeline::~RecordPipeline() {
+    stop();
+}
+
+void RecordPipeline::setSinks(UnifiedWriter* writer, RedisCache* redis, ElasticsearchClient* elasticsearch) {
+    m_writer = writer;
+    m_redis = redis;
+    m_elasticsearch = elasticsearch;
+}
+
+void RecordPipeline::configure(const PipelineConfig& config, int producers) {
+    m_config = config;
+    if (m_config.batch_size == 0) m_config.batch_size = 1;
+
+    for (auto& stage : m_stages) {
+        stage.queue.setCapacity(m_config.queue_batches);
+    }
+
+    m_pending.clear();
+    for (int i = 0; i < producers; ++i) {
+        m_pending.push_back(std::make_unique<RecordBatch>());
+        m_pending.back()->records.reserve(m_config.batch_size);
+    }
+}
+
+void RecordPipeline::start() {
+    if (m_started) return;
+    m_started = true;
+
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        m_stages[stage].queue.reopen();
+        for (int i = 0; i < m_config.threads[stage]; ++i) {
+            m_stages[stage].threads.emplace_back(&RecordPipeline::stageThread, this, stage, i);
+        }
+    }
+}
+
+void RecordPipeline::stop() {
+    if (!m_started) return;
+
+    // producer가 모두 끝났으므로 남은 배치는 여기서 넘겨도 됨
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        flush(static_cast<int>(i));
+    }
+
+    // 앞 단계부터 닫아야 뒤 단계 큐가 열려 있는 동안 마지막 배치를 넘길 수 있음
+    for (auto& stage : m_stages) {
+        stage.queue.close();
+        for (auto& thread : stage.threads) {
+            if (thread.joinable()) thread.join();
+        }
+        stage.threads.clear();
+    }
+    m_started = false;
+}
+
+void RecordPipeline::emit(int producer, const UnifiedRecord& record) {
+    RecordBatch& batch = *m_pending[producer];
+    batch.records.push_back(record);
+    m_emitted++;
+}
+
+void RecordPipeline::flush(int producer) {
+    std::unique_ptr<RecordBatch>& pending = m_pending[producer];
+    if (pending->records.empty()) return;
+
+    std::unique_ptr<RecordBatch> done = forward(0, std::move(pending));
+    if (done) {
+        // 모든 단계를 이 스레드에서 끝냈으면 벡터 용량을 그대로 재사용
+        done->clear();
+        pending = std::move(done);
+    } else {
+        pending = std::make_unique<RecordBatch>();
+        pending->records.reserve(m_config.batch_size);
+    }
+}
+
+std::unique_ptr<RecordBatch> RecordPipeline::forward(int stage, std::unique_ptr<RecordBatch> batch) {
+    for (; stage < STAGE_COUNT; ++stage) {
+        if (m_config.threads[stage] > 0) {
+            m_in_flight++;
+            if (!m_stages[stage].queue.push(std::move(batch))) {
+                m_in_flight--;
+                std::cerr << "[WARN] Pipeline " << STAGE_NAMES[stage] << " stage is stopped, dropping batch" << std::endl;
+            }
+            return nullptr;
+        }
+        runStage(stage, *batch);
+    }
+    return batch;
+}
+
+void RecordPipeline::runStage(int stage, RecordBatch& batch) {
+    auto started = std::chrono::steady_clock::now();
+    try {
+        switch (stage) {
+            case STAGE_ENRICH: enrich(batch); break;
+            case STAGE_SERIALIZE: serialize(batch); break;
+            case STAGE_SINK: sink(batch); break;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] Pipeline " << STAGE_NAMES[stage] << " stage exception: " << e.what() << std::endl;
+    }
+
+    Stage& state = m_stages[stage];
+    state.busy_ns += elapsedNs(started);
+    state.batches++;
+    state.records += batch.records.size();
+}
+
+void RecordPipeline::stageThread(int stage, int index) {
+    ThreadPlacement::apply(ThreadRole::PIPELINE, index);
+
+    std::unique_ptr<RecordBatch> batch;
+    while (m_stages[stage].queue.pop(batch)) {
+        runStage(stage, *batch);
+        forward(stage + 1, std::move(batch));
+        m_in_flight--;
+    }
+}
+
+StageStats RecordPipeline::getStageStats(int stage) const {
+    StageStats stats;
+    const Stage& state = m_stages[stage];
+    stats.threads = m_config.threads[stage];
+    stats.batches = state.batches.load();
+    stats.records = state.records.load();
+    stats.busy_ns = state.busy_ns.load();
+    stats.producer_waits = state.queue.producerWaits();
+    stats.max_depth = state.queue.maxDepth();
+    return stats;
+}
+
+void RecordPipeline::enrich(RecordBatch& batch) {
+    // ES 문서에만 붙는 Redis 자산 정보 (레코드마다 Redis 왕복이 있어 따로 떼어 둠)
+    if (!m_elasticsearch || !m_elasticsearch->isConnected() || !m_redis || !m_redis->isConnected()) {
+        return;
+    }
+
+    batch.src_assets.resize(batch.records.size());
+    batch.dst_assets.resize(batch.records.size());
+    for (size_t i = 0; i < batch.records.size(); ++i) {
+        batch.src_assets[i] = m_redis->getAssetInfo(batch.records[i].sip);
+        batch.dst_assets[i] = m_redis->getAssetInfo(batch.records[i].dip);
+    }
+}
+
+void RecordPipeline::serialize(RecordBatch& batch) {
+    bool use_es = m_elasticsearch && m_elasticsearch->isConnected();
+    bool use_redis = m_redis && m_redis->isConnected();
+    if (!use_es && !use_redis) return;
+
+    if (use_es) batch.es_docs.resize(batch.records.size());
+    if (use_redis) batch.redis_items.resize(batch.records.size());
+
+    for (size_t i = 0; i < batch.records.size(); ++i) {
+        const UnifiedRecord& record = batch.records[i];
+
+        // protocol_details 파싱 (details_json이 있는 경우만, ES/Redis가 같은 결과를 사용)
+        json details = json::object();
+        if (!record.details_json.empty()) {
+            try {
+                details = json::parse(record.details_json);
+            } catch (const std::exception& e) {
+                if (use_es) {
+                    std::cerr << "[WARN] JSON parsing error: " << e.what() << std::endl;
+                }
+                details = json::object();
+            }
+        }
+
+        if (use_es) {
+            json& es_doc = batch.es_docs[i];
+            es_doc["@timestamp"] = record.timestamp;
+            es_doc["protocol"] = record.protocol;
+            es_doc["src_ip"] = record.sip;
+            es_doc["dst_ip"] = record.dip;
+
+            // 포트 파싱
+            try {
+                es_doc["src_port"] = record.sp.empty() ? 0 : std::stoi(record.sp);
+                es_doc["dst_port"] = record.dp.empty() ? 0 : std::stoi(record.dp);
+            } catch (const std::exception& e) {
+                std::cerr << "[WARN] Port parsing error: " << e.what() << std::endl;
+                es_doc["src_port"] = 0;
+                es_doc["dst_port"] = 0;
+            }
+
+            es_doc["src_mac"] = record.smac;
+            es_doc["dst_mac"] = record.dmac;
+            es_doc["direction"] = record.dir;
+            if (!record.vlan.empty()) es_doc["vlan"] = record.vlan;
+            es_doc["protocol_details"] = details;
+
+            // 프로토콜별 중요 필드 추출
+            if (record.protocol == "modbus") {
+                if (!record.modbus_fc.empty()) es_doc["modbus_function"] = record.modbus_fc;
+                if (!record.modbus_addr.empty()) es_doc["modbus_address"] = record.modbus_addr;
+                if (!record.modbus_description.empty()) es_doc["description"] = record.modbus_description;
+            } else if (record.protocol == "s7comm") {
+                if (!record.s7_fn.empty()) es_doc["s7_function"] = record.s7_fn;
+                if (!record.s7_description.empty()) es_doc["description"] = record.s7_description;
+            } else if (record.protocol == "xgt_fen") {
+                if (!record.xgt_cmd.empty()) es_doc["xgt_command"] = record.xgt_cmd;
+                if (!record.xgt_description.empty()) es_doc["description"] = record.xgt_description;
+            }
+
+            // enrich 단계에서 조회한 자산 정보
+            if (i < batch.src_assets.size() && !batch.src_assets[i].asset_id.empty()) {
+                es_doc["src_asset"] = batch.src_assets[i].toJson();
+            }
+            if (i < batch.dst_assets.size() && !batch.dst_assets[i].asset_id.empty()) {
+                es_doc["dst_asset"] = batch.dst_assets[i].toJson();
+            }
+        }
+
+        if (use_redis) {
+            // JSONL 형식과 동일한 짧은 필드명 사용
+            ParsedPacketData& redis_data = batch.redis_items[i];
+            redis_data.timestamp = record.timestamp;
+            redis_data.protocol = record.protocol;
+            redis_data.smac = record.smac;
+            redis_data.dmac = record.dmac;
+            redis_data.sip = record.sip;
+            redis_data.sp = record.sp;
+            redis_data.dip = record.dip;
+            redis_data.dp = record.dp;
+            redis_data.sq = record.sq;
+            redis_data.ak = record.ak;
+            redis_data.fl = record.fl;
+            redis_data.dir = record.dir;
+            redis_data.vlan = record.vlan;
+
+            // 자산 정보 추가
+            redis_data.src_asset_id = record.src_asset_id;
+            redis_data.src_asset_name = record.src_asset_name;
+            redis_data.src_asset_group = record.src_asset_group;
+            redis_data.src_asset_location = record.src_asset_location;
+            redis_data.dst_asset_id = record.dst_asset_id;
+            redis_data.dst_asset_name = record.dst_asset_name;
+            redis_data.dst_asset_group = record.dst_asset_group;
+            redis_data.dst_asset_location = record.dst_asset_location;
+
+            redis_data.protocol_details = std::move(details);
+        }
+    }
+}
+
+void RecordPipeline::sink(RecordBatch& batch) {
+    if (m_writer) {
+        m_writer->addRecords(batch.records);
+    }
+
+    for (size_t i = 0; i < batch.es_docs.size(); ++i) {
+        if (m_elasticsearch->addToBulk(batch.records[i].protocol, batch.es_docs[i])) {
+            // 1000개마다 한번씩 로그 출력
+            static std::atomic<int> es_add_count{0};
+            int count = ++es_add_count;
+            if (count % 1000 == 0) {
+                std::cout << "[Elasticsearch] ✓ Queued " << count << " documents to bulk" << std::endl;
+            }
+        } else {
+            std::cerr << "[WARN] Failed to add to Elasticsearch bulk" << std::endl;
+        }
+    }
+
+    // ★ Redis Stream으로 전송 - 프로토콜명을 키로 사용
+    for (size_t i = 0; i < batch.redis_items.size(); ++i) {
+        std::string stream_name = RedisKeys::protocolStream(batch.records[i].protocol);
+        if (m_redis->pushToStream(stream_name, batch.redis_items[i])) {
+            // 1000개마다 한번씩 로그 출력
+            static std::atomic<int> redis_success_count{0};
+            int count = ++redis_success_count;
+            if (count % 1000 == 0) {
+                std::cout << "[Redis] ✓ Sent " << count << " records to streams" << std::endl;
+            }
+        } else {
+            std::cerr << "[WARN] Failed to push to Redis stream: " << stream_name << std::endl;
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef RECORD_PIPELINE_H
+#define RECORD_PIPELINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "StageQueue.h"
+#include "../UnifiedWriter.h"
+#include "../RedisCache.h"
+#include "../ElasticsearchClient.h"
+
+// decode(worker)가 만든 레코드가 거치는 단계
+enum PipelineStage {
+    STAGE_ENRICH = 0,   // Redis 자산 정보 조회 (ES 문서용)
+    STAGE_SERIALIZE,    // ES 문서 / Redis stream 항목 생성 (details_json 파싱 포함)
+    STAGE_SINK,         // UnifiedWriter, ES bulk, Redis stream으로 전달
+    STAGE_COUNT
+};
+
+const char* pipelineStageName(int stage);
+
+// 단계별 스레드 수 (0 = 앞 단계 스레드에서 바로 실행), 배치 크기, 단계 사이 큐 깊이(배치 수)
+struct PipelineConfig {
+    int threads[STAGE_COUNT] = {0, 0, 0};
+    size_t batch_size = 64;
+    size_t queue_batches = 32;
+
+    // "enrich=1,serialize=2,sink=1" 형식 (일부만 지정 가능)
+    bool parse(const std::string& spec);
+    std::string describe() const;
+};
+
+// 단계 하나의 처리량 (busy_ns는 그 단계가 배치를 처리하는 데 쓴 시간의 합)
+struct StageStats {
+    int threads = 0;
+    uint64_t batches = 0;
+    uint64_t records = 0;
+    uint64_t busy_ns = 0;
+    uint64_t producer_waits = 0;   // 단계 입력 큐가 가득 차서 앞 단계가 대기한 횟수
+    size_t max_depth = 0;          // 단계 입력 큐의 최대 배치 수
+};
+
+// 단계 사이를 오가는 레코드 배치 (각 단계의 결과는 레코드와 같은 index에 채움)
+struct RecordBatch {
+    std::vector<UnifiedRecord> records;
+    std::vector<AssetInfo> src_assets;
+    std::vector<AssetInfo> dst_assets;
+    std::vector<json> es_docs;
+    std::vector<ParsedPacketData> redis_items;
+
+    void clear() {
+        records.clear();
+        src_assets.clear();
+        dst_assets.clear();
+        es_docs.clear();
+        redis_items.clear();
+    }
+};
+
+// decode -> enrich -> serialize -> sink
+// worker(decode)는 emit()으로 자기 배치에 레코드를 모으고, 배치가 차거나 worker가 idle이 되면 다음 단계로 넘깁니다.
+// 스레드가 있는 단계는 bounded StageQueue로 연결되고, 스레드가 0인 단계는 앞 단계 스레드에서 바로 실행됩니다.
+// 같은 패킷에서 나온 레코드는 항상 같은 배치에 있으므로 UnifiedWriter의 stable_sort 순서가 유지됩니다.
+class RecordPipeline {
+public:
+    RecordPipeline();
+    ~RecordPipeline();
+
+    RecordPipeline(const RecordPipeline&) = delete;
+    RecordPipeline& operator=(const RecordPipeline&) = delete;
+
+    // sink 대상 (nullptr = 사용 안 함), start() 전에 설정
+    void setSinks(UnifiedWriter* writer, RedisCache* redis, ElasticsearchClient* elasticsearch);
+    void configure(const PipelineConfig& config, int producers);
+    const PipelineConfig& getConfig() const { return m_config; }
+
+    void start();
+    // producer(worker)가 모두 종료된 뒤 호출: 남은 배치를 넘기고 단계 순서대로 비운 뒤 스레드 종료
+    void stop();
+
+    // producer 스레드에서만 호출 (producer마다 배치가 따로 있음)
+    void emit(int producer, const UnifiedRecord& record);
+    // 패킷 하나를 끝낼 때마다 호출, 배치가 차면 넘김 (패킷의 레코드가 여러 배치로 나뉘지 않도록)
+    void endPacket(int producer) {
+        if (m_pending[producer]->records.size() >= m_config.batch_size) flush(producer);
+    }
+    void flush(int producer);
+
+    bool isStarted() const { return m_started; }
+
+    // 단계 큐가 모두 비고 처리 중인 배치가 없음
+    bool isIdle() const { return m_in_flight.load() == 0; }
+
+    uint64_t getEmittedRecords() const { return m_emitted.load(); }
+    StageStats getStageStats(int stage) const;
+
+private:
+    struct Stage {
+        StageQueue<std::unique_ptr<RecordBatch>> queue;
+        std::vector<std::thread> threads;
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> records{0};
+        std::atomic<uint64_t> busy_ns{0};
+    };
+
+    PipelineConfig m_config;
+    Stage m_stages[STAGE_COUNT];
+    std::vector<std::unique_ptr<RecordBatch>> m_pending;   // producer별 모으는 중인 배치
+    std::atomic<size_t> m_in_flight{0};
+    std::atomic<uint64_t> m_emitted{0};
+    bool m_started = false;
+
+    UnifiedWriter* m_writer = nullptr;
+    RedisCache* m_redis = nullptr;
+    ElasticsearchClient* m_elasticsearch = nullptr;
+
+    void stageThread(int stage, int index);
+    // stage부터 순서대로 실행하다 스레드가 있는 단계를 만나면 그 큐에 넘김
+    // (batch를 넘겼으면 nullptr, 끝까지 실행했으면 재사용할 수 있도록 그대로 반환)
+    std::unique_ptr<RecordBatch> forward(int stage, std::unique_ptr<RecordBatch> batch);
+    void runStage(int stage, RecordBatch& batch);
+
+    void enrich(RecordBatch& batch);
+    void serialize(RecordBatch& batch);
+    void sink(RecordBatch& batch);
+};
+
+#endif // RECORD_PIPELINE_H
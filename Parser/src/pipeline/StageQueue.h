@@ -0,0 +1,100 @@
+#ifndef STAGE_QUEUE_H
+#define STAGE_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// 파이프라인 단계 사이의 bounded 큐 (여러 producer / 여러 consumer)
+// 항목 하나가 레코드 배치이므로 lock은 배치당 한 번만 잡습니다.
+// 가득 차면 push()가 대기해서 뒤 단계가 밀리면 앞 단계(결국 캡처 큐)까지 back-pressure가 전달됩니다.
+template <typename T>
+class StageQueue {
+public:
+    explicit StageQueue(size_t capacity = 32) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+    StageQueue(const StageQueue&) = delete;
+    StageQueue& operator=(const StageQueue&) = delete;
+
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity > 0 ? capacity : 1;
+    }
+
+    // close() 이후에는 false (항목은 버려짐)
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_items.size() >= m_capacity && !m_closed) {
+            m_producer_waits++;
+            m_not_full.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+        }
+        if (m_closed) return false;
+
+        m_items.push_back(std::move(item));
+        if (m_items.size() > m_max_depth) m_max_depth = m_items.size();
+        lock.unlock();
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    // 항목이 올 때까지 대기, close()되고 비어 있으면 false
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+        if (m_items.empty()) return false;
+
+        item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return true;
+    }
+
+    // 남은 항목은 consumer가 계속 꺼낼 수 있음
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+    void reopen() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = false;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.size();
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+    // 큐가 가득 차서 producer가 대기한 횟수
+    uint64_t producerWaits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_producer_waits;
+    }
+
+    size_t maxDepth() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_max_depth;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::deque<T> m_items;
+    size_t m_capacity;
+    bool m_closed = false;
+    uint64_t m_producer_waits = 0;
+    size_t m_max_depth = 0;
+};
+
+#endif // STAGE_QUEUE_H
@@ -21,16 +21,18 @@ bool ArpParser::isProtocol(const PacketInfo& info) const {
     return info.eth_type == 0x0806;
 }
 
+std::string ArpParser::getCaptureFilter() const {
+    return "arp";
+}
+
 void ArpParser::parse(const PacketInfo& info) {
     // size_t로 캐스팅하여 signed/unsigned 비교 경고 제거
     if (static_cast<size_t>(info.payload_size) < sizeof(ARPHeader)) return;
 
     const ARPHeader* arp_header = reinterpret_cast<const ARPHeader*>(info.payload);
 
-    char spa_str[INET_ADDRSTRLEN];
-    char tpa_str[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, (void*)arp_header->spa, spa_str, INET_ADDRSTRLEN);
-    inet_ntop(AF_INET, (void*)arp_header->tpa, tpa_str, INET_ADDRSTRLEN);
+    std::string spa_str = packet_format::ipv4(arp_header->spa);
+    std::string tpa_str = packet_format::ipv4(arp_header->tpa);
 
     uint16_t op_code = ntohs(arp_header->oper);
     std::string sha_str = mac_to_string(arp_header->sha);
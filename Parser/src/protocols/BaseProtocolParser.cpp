@@ -1,17 +1,25 @@
 #include "BaseProtocolParser.h"
 #include "../UnifiedWriter.h"
 #include "../AssetManager.h"
-#include <sstream>
-#include <iomanip>
 #include <iostream>
+#include <cstring>
 
-std::string BaseProtocolParser::mac_to_string(const uint8_t* mac) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (int i = 0; i < 6; ++i) {
-        ss << std::setw(2) << static_cast<int>(mac[i]) << (i < 5 ? ":" : "");
+// flow 캐시에 없거나 MAC이 바뀐 endpoint만 다시 문자열로 변환
+void BaseProtocolParser::fillEndpointText(EndpointText& text, const uint8_t* mac,
+                                          const IpAddress& ip, uint16_t port) {
+    if (text.ip_text.empty()) {
+        text.ip_text = ip.toString();
+        text.port_text = std::to_string(port);
+        std::memcpy(text.mac, mac, 6);
+        text.mac_text = packet_format::mac(mac);
+    } else if (std::memcmp(text.mac, mac, 6) != 0) {
+        std::memcpy(text.mac, mac, 6);
+        text.mac_text = packet_format::mac(mac);
     }
-    return ss.str();
+}
+
+std::string BaseProtocolParser::mac_to_string(const uint8_t* mac) {
+    return packet_format::mac(mac);
 }
 
 BaseProtocolParser::~BaseProtocolParser() {}
@@ -35,18 +43,41 @@ std::string BaseProtocolParser::escape_csv(const std::string& s) {
 
 UnifiedRecord BaseProtocolParser::createUnifiedRecord(const PacketInfo& info, const std::string& direction) {
     UnifiedRecord record;
-    record.timestamp = info.timestamp;
+    // 디코딩된 고정 길이 필드는 레코드로 내보낼 때 처음으로 문자열이 됨
+    record.timestamp = info.timestampString();
+    record.ts_ns = info.ts_ns;
     record.protocol = getName();
-    record.smac = info.src_mac;
-    record.dmac = info.dst_mac;
-    record.sip = info.src_ip;
-    record.sp = std::to_string(info.src_port);
-    record.dip = info.dst_ip;
-    record.dp = std::to_string(info.dst_port);
+    if (info.src_ip.empty()) {
+        // ARP 등 IP가 없는 패킷은 flow가 없으므로 바로 변환
+        record.smac = info.srcMacString();
+        record.dmac = info.dstMacString();
+        record.sp = std::to_string(info.src_port);
+        record.dp = std::to_string(info.dst_port);
+    } else {
+        bool swapped = false;
+        FlowKey key = info.flowKey(&swapped);
+        auto it = m_flow_text.find(key);
+        if (it == m_flow_text.end()) {
+            if (m_flow_text.size() >= FLOW_TEXT_CACHE_MAX) m_flow_text.clear();
+            it = m_flow_text.emplace(key, FlowText()).first;
+        }
+        EndpointText& src = swapped ? it->second.b : it->second.a;
+        EndpointText& dst = swapped ? it->second.a : it->second.b;
+        fillEndpointText(src, info.src_mac, info.src_ip, info.src_port);
+        fillEndpointText(dst, info.dst_mac, info.dst_ip, info.dst_port);
+
+        record.smac = src.mac_text;
+        record.dmac = dst.mac_text;
+        record.sip = src.ip_text;
+        record.sp = src.port_text;
+        record.dip = dst.ip_text;
+        record.dp = dst.port_text;
+    }
     record.sq = std::to_string(info.tcp_seq);
     record.ak = std::to_string(info.tcp_ack);
     record.fl = std::to_string((int)info.tcp_flags);
     record.dir = direction;
+    record.vlan = info.vlanString();
 
     // 자산 정보 추가
     if (m_asset_manager) {
@@ -55,11 +86,11 @@ UnifiedRecord BaseProtocolParser::createUnifiedRecord(const PacketInfo& info, co
 
         if (!src_device.empty()) {
             record.src_asset_name = src_device;
-            record.src_asset_id = info.src_ip;
+            record.src_asset_id = record.sip;
         }
         if (!dst_device.empty()) {
             record.dst_asset_name = dst_device;
-            record.dst_asset_id = info.dst_ip;
+            record.dst_asset_id = record.dip;
         }
     }
 
@@ -4,6 +4,7 @@
 #include "IProtocolParser.h"
 #include <string>
 #include <fstream>
+#include <unordered_map>
 
 // Forward declaration
 class UnifiedWriter;
@@ -35,11 +36,33 @@ public:
         return false;
     }
 
+    std::string getCaptureFilter() const override {
+        return "";
+    }
+
 protected:
     UnifiedRecord createUnifiedRecord(const PacketInfo& info, const std::string& direction);
     void addUnifiedRecord(const UnifiedRecord& record);
     std::string escape_csv(const std::string& s);
 
+    // flow 한쪽 endpoint의 문자열 (MAC은 경로에 따라 바뀔 수 있어 바이트를 같이 보관)
+    struct EndpointText {
+        uint8_t mac[6] = {};
+        std::string mac_text;
+        std::string ip_text;
+        std::string port_text;
+    };
+
+    struct FlowText {
+        EndpointText a;
+        EndpointText b;
+    };
+
+    // 같은 flow의 레코드는 주소/포트를 한 번만 문자열로 만듦 (파서는 worker마다 따로 있어 lock 없음)
+    static const size_t FLOW_TEXT_CACHE_MAX = 4096;
+    std::unordered_map<FlowKey, FlowText, FlowKeyHash> m_flow_text;
+    static void fillEndpointText(EndpointText& text, const uint8_t* mac, const IpAddress& ip, uint16_t port);
+
     UnifiedWriter* m_unified_writer = nullptr;
     AssetManager* m_asset_manager = nullptr;
     std::function<void(const UnifiedRecord&)> m_direct_backend_callback;  // 추가
@@ -16,6 +16,10 @@ bool Dnp3Parser::isProtocol(const PacketInfo& info) const {
            info.payload[1] == 0x64;
 }
 
+std::string Dnp3Parser::getCaptureFilter() const {
+    return "port 20000";
+}
+
 void Dnp3Parser::parse(const PacketInfo& info) {
     uint8_t len = 0, ctrl = 0;
     uint16_t dest = 0, src = 0;
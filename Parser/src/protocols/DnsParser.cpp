@@ -21,6 +21,10 @@ bool DnsParser::isProtocol(const PacketInfo& info) const {
            info.payload_size >= 12;
 }
 
+std::string DnsParser::getCaptureFilter() const {
+    return "udp port 53";
+}
+
 void DnsParser::parse(const PacketInfo& info) {
     if (info.payload_size < 12) return;
     
@@ -24,6 +24,17 @@ bool GenericParser::isProtocol(const PacketInfo& info) const {
     return false;
 }
 
+std::string GenericParser::getCaptureFilter() const {
+    // isProtocol()과 같은 포트 목록 유지
+    if (m_name == "ethernet_ip") return "tcp port 44818";
+    if (m_name == "iec104") return "tcp port 2404";
+    if (m_name == "mms") return "tcp port 102";
+    if (m_name == "opc_ua") return "tcp port 4840";
+    if (m_name == "dhcp") return "udp port 67 or udp port 68";
+    if (m_name == "bacnet") return "udp port 47808";
+    return "";
+}
+
 void GenericParser::parse(const PacketInfo& info) {
     std::string direction = "unknown";
     
@@ -71,6 +71,10 @@ bool ModbusParser::isProtocol(const PacketInfo& info) const {
     return true;
 }
 
+std::string ModbusParser::getCaptureFilter() const {
+    return "tcp port 502";
+}
+
 void ModbusParser::parse(const PacketInfo& info) {
     // 주기적으로 오래된 요청 정리 (선택사항)
     cleanupOldRequests();
@@ -87,25 +91,8 @@ void ModbusParser::parse(const PacketInfo& info) {
     std::string direction = is_request ? "request" : "response";
     uint8_t current_fc = pdu[0] & 0x7F;
     
-    // Flow 키 생성
-    std::string flow_key;
-    std::string client_ip, server_ip;
-    uint16_t client_port, server_port;
-    
-    if (info.src_port == 502) {
-        server_ip = info.src_ip;
-        server_port = info.src_port;
-        client_ip = info.dst_ip;
-        client_port = info.dst_port;
-    } else {
-        server_ip = info.dst_ip;
-        server_port = info.dst_port;
-        client_ip = info.src_ip;
-        client_port = info.src_port;
-    }
-    
-    flow_key = client_ip + ":" + std::to_string(client_port) + "->" + 
-               server_ip + ":" + std::to_string(server_port);
+    // Flow 키 생성 (양방향 공통이므로 요청/응답이 같은 키, 문자열 변환 없음)
+    const FlowKey flow_key = info.flowKey();
 
     uint32_t req_key = (static_cast<uint32_t>(trans_id) << 8) | current_fc;
     ModbusRequestInfo* req_info_ptr = nullptr;
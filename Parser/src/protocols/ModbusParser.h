@@ -4,6 +4,7 @@
 #include "BaseProtocolParser.h"
 #include "../AssetManager.h"
 #include <map>
+#include <unordered_map>
 #include <chrono>
 
 struct ModbusRequestInfo {
@@ -19,11 +20,12 @@ public:
     
     std::string getName() const override;
     bool isProtocol(const PacketInfo& info) const override;
+    std::string getCaptureFilter() const override;
     void parse(const PacketInfo& info) override;
 
 private:
     AssetManager& m_assetManager;
-    std::map<std::string, std::map<uint32_t, ModbusRequestInfo>> m_pending_requests;
+    std::unordered_map<FlowKey, std::map<uint32_t, ModbusRequestInfo>, FlowKeyHash> m_pending_requests;
     
     // 타임아웃 정리 (선택사항 - 프로덕션에서 사용)
     std::chrono::steady_clock::time_point m_last_cleanup = std::chrono::steady_clock::now();
@@ -42,6 +42,10 @@ bool S7CommParser::isProtocol(const PacketInfo& info) const {
            info.payload[7] == 0x32;
 }
 
+std::string S7CommParser::getCaptureFilter() const {
+    return "tcp port 102";
+}
+
 void S7CommParser::parse(const PacketInfo& info) {
     const u_char* s7_pdu = info.payload + 7;
     int s7_pdu_len = info.payload_size - 7;
@@ -52,13 +56,14 @@ void S7CommParser::parse(const PacketInfo& info) {
     uint16_t param_len = safe_ntohs(s7_pdu + 6);
     uint16_t data_len = safe_ntohs(s7_pdu + 8);
     int header_size = (rosctr == 0x01 || rosctr == 0x07) ? 10 : 12;
+    const FlowKey flow_id = info.flowKey();
 
     std::string direction;
     S7CommRequestInfo* req_info_ptr = nullptr;
 
-    if ((rosctr == 0x02 || rosctr == 0x03) && m_pending_requests[info.flow_id].count(pdu_ref)) {
+    if ((rosctr == 0x02 || rosctr == 0x03) && m_pending_requests[flow_id].count(pdu_ref)) {
         direction = "response";
-        req_info_ptr = &m_pending_requests[info.flow_id][pdu_ref];
+        req_info_ptr = &m_pending_requests[flow_id][pdu_ref];
     } else if (rosctr == 0x01) {
         direction = "request";
         S7CommRequestInfo new_req;
@@ -73,8 +78,8 @@ void S7CommParser::parse(const PacketInfo& info) {
                 new_req.items.resize(item_count);
             }
         }
-        m_pending_requests[info.flow_id][pdu_ref] = new_req;
-        req_info_ptr = &m_pending_requests[info.flow_id][pdu_ref];
+        m_pending_requests[flow_id][pdu_ref] = new_req;
+        req_info_ptr = &m_pending_requests[flow_id][pdu_ref];
     } else {
         return;
     }
@@ -170,6 +175,6 @@ void S7CommParser::parse(const PacketInfo& info) {
     addUnifiedRecord(record);
 
     if (direction == "response") {
-        m_pending_requests[info.flow_id].erase(pdu_ref);
+        m_pending_requests[flow_id].erase(pdu_ref);
     }
 }
\ No newline at end of file
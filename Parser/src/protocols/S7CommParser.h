@@ -6,6 +6,7 @@
 #include <chrono>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 struct S7CommItem {};
 
@@ -23,11 +24,12 @@ public:
 
     std::string getName() const override;
     bool isProtocol(const PacketInfo& info) const override;
+    std::string getCaptureFilter() const override;
     void parse(const PacketInfo& info) override;
 
 private:
     AssetManager& m_assetManager;
-    std::map<std::string, std::map<uint16_t, S7CommRequestInfo>> m_pending_requests;
+    std::unordered_map<FlowKey, std::map<uint16_t, S7CommRequestInfo>, FlowKeyHash> m_pending_requests;
 };
 
 #endif // S7COMM_PARSER_H
\ No newline at end of file
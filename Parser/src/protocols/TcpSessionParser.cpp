@@ -15,6 +15,11 @@ bool TcpSessionParser::isProtocol(const PacketInfo& info) const {
     return true;
 }
 
+std::string TcpSessionParser::getCaptureFilter() const {
+    // 모든 TCP 세션을 기록하므로 포트 제한 없음
+    return "tcp";
+}
+
 void TcpSessionParser::parse(const PacketInfo& info) {
     UnifiedRecord record = createUnifiedRecord(info, "unknown");
 
@@ -10,6 +10,7 @@ public:
 
     std::string getName() const override;
     bool isProtocol(const PacketInfo& info) const override;
+    std::string getCaptureFilter() const override;
     void parse(const PacketInfo& info) override;
 };
 
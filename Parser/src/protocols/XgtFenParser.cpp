@@ -66,6 +66,10 @@ bool XgtFenParser::isProtocol(const PacketInfo& info) const {
            memcmp(info.payload, "LSIS-XGT", 8) == 0);
 }
 
+std::string XgtFenParser::getCaptureFilter() const {
+    return "port 2004";
+}
+
 bool XgtFenParser::parseHeader(const u_char* payload, size_t size, XgtFenHeader& header) {
     if (size < 20) return false;
 
@@ -313,7 +317,7 @@ void XgtFenParser::parse(const PacketInfo& info) {
     if (20 + header.length != info.payload_size) {
         std::cerr << "XGT FEN Size Mismatch. Header len: " << header.length
                   << ", Actual inst size: " << (info.payload_size - 20)
-                  << ". Timestamp: " << info.timestamp << std::endl;
+                  << ". Timestamp: " << info.timestampString() << std::endl;
     }
 
     XgtFenInstruction instruction = {};
@@ -0,0 +1,167 @@
+// g++ -std=c++17 -Isrc test_ipv4_reassembler.cpp src/network/Ipv4Reassembler.cpp -lpcap -o test_ipv4_reassembler
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include "network/Ipv4Reassembler.h"
+#include "network/packet_decoder.h"
+
+static const uint32_t ETH_LEN = 14;
+static const uint32_t IP_LEN = 20;
+
+// UDP datagram 하나 (8바이트 UDP 헤더 + 패턴 payload)
+static std::vector<uint8_t> makeDatagram(size_t size) {
+    std::vector<uint8_t> d(size);
+    for (size_t i = 0; i < size; ++i) d[i] = static_cast<uint8_t>(i * 7);
+    d[0] = 0x4e; d[1] = 0x20;   // sport 20000
+    d[2] = 0x4e; d[3] = 0x21;   // dport 20001
+    d[4] = static_cast<uint8_t>(size >> 8); d[5] = static_cast<uint8_t>(size);
+    return d;
+}
+
+// datagram의 [offset, offset + len) 구간을 담은 Ethernet + IPv4 조각
+static std::vector<uint8_t> makeFragment(const std::vector<uint8_t>& datagram, uint16_t id,
+                                         uint32_t offset, uint32_t len, bool more) {
+    std::vector<uint8_t> p(ETH_LEN + IP_LEN + len, 0);
+    p[12] = 0x08; p[13] = 0x00;
+    uint8_t* ip = &p[ETH_LEN];
+    ip[0] = 0x45;
+    ip[2] = static_cast<uint8_t>((IP_LEN + len) >> 8); ip[3] = static_cast<uint8_t>(IP_LEN + len);
+    ip[4] = static_cast<uint8_t>(id >> 8); ip[5] = static_cast<uint8_t>(id);
+    uint16_t off = static_cast<uint16_t>((offset / 8) | (more ? 0x2000 : 0));
+    ip[6] = static_cast<uint8_t>(off >> 8); ip[7] = static_cast<uint8_t>(off);
+    ip[8] = 64; ip[9] = 17;
+    ip[12] = 10; ip[15] = 1;   // 10.0.0.1
+    ip[16] = 10; ip[19] = 2;   // 10.0.0.2
+    memcpy(ip + IP_LEN, datagram.data() + offset, len);
+    return p;
+}
+
+// 조각에 802.1Q 태그 하나를 끼워 넣음 (VLAN 100)
+static std::vector<uint8_t> addVlanTag(const std::vector<uint8_t>& frame) {
+    std::vector<uint8_t> tagged(frame.begin(), frame.begin() + 12);
+    const uint8_t tag[4] = {0x81, 0x00, 0x00, 100};
+    tagged.insert(tagged.end(), tag, tag + 4);
+    tagged.insert(tagged.end(), frame.begin() + 12, frame.end());
+    return tagged;
+}
+
+static const u_char* feed(Ipv4Reassembler& r, const std::vector<uint8_t>& frame, time_t sec, struct pcap_pkthdr& whole,
+                          uint32_t l3_offset = ETH_LEN) {
+    struct pcap_pkthdr header;
+    memset(&header, 0, sizeof(header));
+    header.ts.tv_sec = sec;
+    header.caplen = header.len = static_cast<bpf_u_int32>(frame.size());
+    return r.add(&header, frame.data(), l3_offset, whole);
+}
+
+static ReassemblyStats stats(const Ipv4Reassembler& r) {
+    ReassemblyStats s;
+    r.addStatsTo(s);
+    return s;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << (ok ? "  PASS: " : "  FAIL: ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+int main() {
+    std::vector<uint8_t> datagram = makeDatagram(3000);
+    struct pcap_pkthdr whole;
+
+    std::cout << "out-of-order fragments:" << std::endl;
+    {
+        Ipv4Reassembler r;
+        std::vector<uint8_t> first = makeFragment(datagram, 1, 0, 1480, true);
+        std::vector<uint8_t> middle = makeFragment(datagram, 1, 1480, 1480, true);
+        std::vector<uint8_t> last = makeFragment(datagram, 1, 2960, 40, false);
+
+        check(feed(r, last, 100, whole) == nullptr, "last fragment alone is held");
+        check(feed(r, first, 100, whole) == nullptr, "first fragment is held");
+        const u_char* out = feed(r, middle, 100, whole);
+        check(out != nullptr, "middle fragment completes the datagram");
+
+        PacketInfo info;
+        DecodeResult result = out ? packet_decoder::decode(DLT_EN10MB, &whole, out, false, info) : DECODE_TRUNCATED;
+        check(result == DECODE_OK && info.src_port == 20000 && info.dst_port == 20001, "reassembled datagram decodes as UDP");
+        check(result == DECODE_OK && info.payload_size == 2992 && memcmp(info.payload, datagram.data() + 8, 2992) == 0,
+              "payload bytes in order");
+        check(out && (out[ETH_LEN + 6] & 0x3f) == 0 && out[ETH_LEN + 7] == 0, "MF and offset cleared");
+
+        ReassemblyStats s = stats(r);
+        check(s.fragments == 3 && s.completed == 1 && s.bytes_in_use == 0, "stats and table emptied");
+    }
+
+    std::cout << "overlapping fragments:" << std::endl;
+    {
+        Ipv4Reassembler r;
+        check(feed(r, makeFragment(datagram, 2, 0, 1000, true), 100, whole) == nullptr, "first fragment [0, 1000)");
+        check(feed(r, makeFragment(datagram, 2, 800, 1600, true), 100, whole) == nullptr, "overlapping fragment [800, 2400)");
+        const u_char* out = feed(r, makeFragment(datagram, 2, 2400, 600, false), 100, whole);
+        check(out != nullptr, "last fragment completes the datagram");
+
+        PacketInfo info;
+        DecodeResult result = out ? packet_decoder::decode(DLT_EN10MB, &whole, out, false, info) : DECODE_TRUNCATED;
+        check(result == DECODE_OK && info.payload_size == 2992 && memcmp(info.payload, datagram.data() + 8, 2992) == 0,
+              "overlap merged without gaps");
+    }
+
+    std::cout << "fragments with different VLAN tag counts:" << std::endl;
+    {
+        // 첫 조각만 태그가 있으면 출력 헤더의 IP 위치는 첫 조각 기준이어야 함
+        Ipv4Reassembler r;
+        std::vector<uint8_t> first = addVlanTag(makeFragment(datagram, 8, 0, 1480, true));
+        check(feed(r, first, 100, whole, ETH_LEN + 4) == nullptr, "tagged first fragment is held");
+        const u_char* out = feed(r, makeFragment(datagram, 8, 1480, 1520, false), 100, whole);
+        check(out != nullptr, "untagged last fragment completes the datagram");
+
+        PacketInfo info;
+        DecodeResult result = out ? packet_decoder::decode(DLT_EN10MB, &whole, out, false, info) : DECODE_TRUNCATED;
+        check(result == DECODE_OK && info.vlan_count == 1 && info.vlan_ids[0] == 100, "first fragment's VLAN tag kept");
+        check(result == DECODE_OK && info.payload_size == 2992 && memcmp(info.payload, datagram.data() + 8, 2992) == 0,
+              "IP length patched at the first fragment's header");
+    }
+
+    std::cout << "missing last fragment:" << std::endl;
+    {
+        ReassemblyConfig config;
+        config.timeout_sec = 30;
+        Ipv4Reassembler r(config);
+        check(feed(r, makeFragment(datagram, 3, 0, 1480, true), 100, whole) == nullptr, "first fragment is held");
+        check(feed(r, makeFragment(datagram, 3, 1480, 1480, true), 110, whole) == nullptr, "middle fragment is held");
+        check(stats(r).bytes_in_use > 0, "incomplete datagram uses memory");
+
+        // 다른 datagram의 조각이 timeout 이후에 오면 sweep이 돌아감
+        feed(r, makeFragment(datagram, 4, 0, 1480, true), 131, whole);
+        ReassemblyStats s = stats(r);
+        check(s.timed_out == 1 && s.completed == 0, "incomplete datagram expires after timeout_sec");
+        check(s.bytes_in_use == ETH_LEN + IP_LEN + 1480, "only the new fragment remains");
+        check(feed(r, makeFragment(datagram, 3, 2960, 40, false), 131, whole) == nullptr,
+              "late last fragment does not complete an expired datagram");
+    }
+
+    std::cout << "memory cap:" << std::endl;
+    {
+        ReassemblyConfig config;
+        config.max_bytes = 4000;
+        Ipv4Reassembler r(config);
+        feed(r, makeFragment(datagram, 5, 0, 1480, true), 100, whole);
+        feed(r, makeFragment(datagram, 6, 0, 1480, true), 101, whole);
+        check(stats(r).evicted_memory == 0, "two datagrams fit under the cap");
+
+        feed(r, makeFragment(datagram, 7, 0, 1480, true), 102, whole);
+        ReassemblyStats s = stats(r);
+        check(s.evicted_memory == 1, "third datagram evicts the oldest entry");
+        check(s.bytes_in_use <= config.max_bytes, "memory stays under the cap");
+
+        // 남아 있는 id 6은 완성되고, 밀려난 id 5는 남은 조각이 와도 첫 조각이 없어 완성되지 않음
+        check(feed(r, makeFragment(datagram, 6, 1480, 1520, false), 102, whole) != nullptr, "surviving datagram completes");
+        check(feed(r, makeFragment(datagram, 5, 1480, 1520, false), 102, whole) == nullptr, "evicted datagram stays incomplete");
+    }
+
+    std::cout << (failures == 0 ? "All tests passed" : "Some tests failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
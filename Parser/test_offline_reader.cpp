@@ -0,0 +1,84 @@
+// g++ -std=c++17 -Isrc test_offline_reader.cpp src/capture/OfflinePcapReader.cpp -lpcap -o test_offline_reader
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include "capture/OfflinePcapReader.h"
+
+static void put16(std::vector<uint8_t>& b, uint16_t v, bool big = false) {
+    for (int i = 0; i < 2; ++i) b.push_back(big ? (v >> (8 * (1 - i))) & 0xff : (v >> (8 * i)) & 0xff);
+}
+
+static void put32(std::vector<uint8_t>& b, uint32_t v, bool big = false) {
+    for (int i = 0; i < 4; ++i) b.push_back(big ? (v >> (8 * (3 - i))) & 0xff : (v >> (8 * i)) & 0xff);
+}
+
+static void writeFile(const char* path, const std::vector<uint8_t>& b) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(b.data()), b.size());
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << (ok ? "  PASS: " : "  FAIL: ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+int main() {
+    const uint8_t frame[14] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0x08, 0x00};
+
+    // Big-endian 나노초 pcap, 레코드 2개 + 잘린 레코드
+    std::vector<uint8_t> pcap;
+    put32(pcap, 0xa1b23c4d, true); put16(pcap, 2, true); put16(pcap, 4, true);
+    put32(pcap, 0, true); put32(pcap, 0, true); put32(pcap, 65535, true); put32(pcap, 1, true);
+    for (uint32_t i = 0; i < 2; ++i) {
+        put32(pcap, 1700000000 + i, true); put32(pcap, 123456789, true);
+        put32(pcap, sizeof(frame), true); put32(pcap, 60, true);
+        pcap.insert(pcap.end(), frame, frame + sizeof(frame));
+    }
+    put32(pcap, 1700000002, true); put32(pcap, 0, true);
+    writeFile("/tmp/test_offline_reader.pcap", pcap);
+
+    std::cout << "pcap (big-endian, nanosecond):" << std::endl;
+    OfflinePcapReader reader(false);
+    check(reader.open("/tmp/test_offline_reader.pcap"), "open");
+    OfflineChunk chunk;
+    check(reader.nextChunk(chunk, 16) && chunk.size() == 2, "two complete records");
+    check(chunk.size() == 2 && chunk[1].header.ts.tv_sec == 1700000001, "seconds");
+    check(chunk.size() == 2 && chunk[0].header.ts.tv_usec == 123456, "nanoseconds scaled to microseconds");
+    check(chunk.size() == 2 && chunk[0].header.len == 60 && memcmp(chunk[0].data, frame, sizeof(frame)) == 0,
+          "length and zero-copy payload");
+    check(!reader.nextChunk(chunk, 16), "truncated record ends the file");
+
+    // pcapng: if_tsresol=10^-3 인터페이스, EPB 하나 + SPB 하나
+    std::vector<uint8_t> ng;
+    put32(ng, 0x0A0D0D0A); put32(ng, 28); put32(ng, 0x1A2B3C4D); put16(ng, 1); put16(ng, 0);
+    put32(ng, 0xffffffff); put32(ng, 0xffffffff); put32(ng, 28);
+    put32(ng, 1); put32(ng, 32); put16(ng, 1); put16(ng, 0); put32(ng, 65535);
+    put16(ng, 9); put16(ng, 1); ng.push_back(3); ng.push_back(0); ng.push_back(0); ng.push_back(0);
+    put32(ng, 0); put32(ng, 32);
+    uint64_t ts_ms = 1700000000123ULL;
+    put32(ng, 6); put32(ng, 32 + 16); put32(ng, 0);
+    put32(ng, static_cast<uint32_t>(ts_ms >> 32)); put32(ng, static_cast<uint32_t>(ts_ms));
+    put32(ng, sizeof(frame)); put32(ng, sizeof(frame));
+    ng.insert(ng.end(), frame, frame + sizeof(frame)); ng.push_back(0); ng.push_back(0);
+    put32(ng, 32 + 16);
+    put32(ng, 3); put32(ng, 16 + 16); put32(ng, sizeof(frame));
+    ng.insert(ng.end(), frame, frame + sizeof(frame)); ng.push_back(0); ng.push_back(0);
+    put32(ng, 16 + 16);
+    writeFile("/tmp/test_offline_reader.pcapng", ng);
+
+    std::cout << "pcapng (if_tsresol, EPB + SPB):" << std::endl;
+    OfflinePcapReader ng_reader(true);
+    check(ng_reader.open("/tmp/test_offline_reader.pcapng"), "open");
+    check(ng_reader.nextChunk(chunk, 16) && chunk.size() == 2, "EPB and SPB records");
+    check(chunk.size() == 2 && chunk[0].header.ts.tv_sec == 1700000000 &&
+          chunk[0].header.ts.tv_usec == 123000000, "millisecond resolution to nanoseconds");
+    check(chunk.size() == 2 && chunk[1].header.caplen == sizeof(frame) && chunk[1].linktype == DLT_EN10MB,
+          "SPB length and link type");
+
+    std::cout << (failures == 0 ? "All tests passed" : "Some tests failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// g++ -std=c++17 -Isrc test_tcp_stream_reassembler.cpp src/network/TcpStreamReassembler.cpp -lpcap -o test_tcp_stream_reassembler
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include "network/TcpStreamReassembler.h"
+#include "network/network_headers.h"
+
+typedef std::vector<uint8_t> Bytes;
+
+// Modbus/TCP Read Holding Registers 요청 (MBAP 7 + PDU 5 = 12바이트)
+static Bytes mbap(uint16_t tid) {
+    Bytes adu = {0, 0, 0, 0, 0, 6, 1, 3, 0, 0, 0, 10};
+    adu[0] = static_cast<uint8_t>(tid >> 8);
+    adu[1] = static_cast<uint8_t>(tid);
+    return adu;
+}
+
+// TPKT + COTP DT + 4바이트 S7 데이터 (11바이트)
+static Bytes tpkt() {
+    return {0x03, 0x00, 0x00, 0x0b, 0x02, 0xf0, 0x80, 0x32, 0x01, 0x00, 0x00};
+}
+
+static Bytes concat(const Bytes& a, const Bytes& b) {
+    Bytes out(a);
+    out.insert(out.end(), b.begin(), b.end());
+    return out;
+}
+
+static Bytes slice(const Bytes& b, size_t begin, size_t end) {
+    return Bytes(b.begin() + begin, b.begin() + end);
+}
+
+// 한 방향(10.0.0.1:40000 -> 10.0.0.2:502) segment를 넣고 받은 PDU를 모아 둠
+struct Client {
+    TcpStreamReassembler reassembler;
+    TcpFraming framing = FRAMING_MBAP;
+    std::vector<Bytes> pdus;
+    std::vector<const u_char*> pointers;
+
+    explicit Client(const TcpStreamConfig& config = TcpStreamConfig()) : reassembler(config) {}
+
+    int send(uint32_t seq, const Bytes& data, uint8_t flags = TH_ACK, time_t sec = 100) {
+        PacketInfo info;
+        info.ts.tv_sec = sec;
+        info.protocol = 6;
+        IpAddress::parse("10.0.0.1", info.src_ip);
+        IpAddress::parse("10.0.0.2", info.dst_ip);
+        info.src_port = 40000;
+        info.dst_port = 502;
+        info.tcp_seq = seq;
+        info.tcp_flags = flags;
+        info.payload = data.empty() ? nullptr : data.data();
+        info.payload_size = static_cast<int>(data.size());
+        pdus.clear();
+        pointers.clear();
+        return reassembler.add(info, framing, [this](const u_char* pdu, int size) {
+            pdus.push_back(Bytes(pdu, pdu + size));
+            pointers.push_back(pdu);
+        });
+    }
+
+    TcpStreamStats stats() const {
+        TcpStreamStats s;
+        reassembler.addStatsTo(s);
+        return s;
+    }
+};
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    std::cout << (ok ? "  PASS: " : "  FAIL: ") << what << std::endl;
+    if (!ok) failures++;
+}
+
+int main() {
+    std::cout << "in-order segments:" << std::endl;
+    {
+        Client c;
+        Bytes segment = concat(mbap(1), mbap(2));
+        check(c.send(1000, segment) == 2, "two ADUs in one segment");
+        check(c.pdus.size() == 2 && c.pdus[0] == mbap(1) && c.pdus[1] == mbap(2), "ADUs delivered in order");
+        check(c.pointers.size() == 2 && c.pointers[0] == segment.data() && c.pointers[1] == segment.data() + 12,
+              "ADUs point into the segment (no copy)");
+        check(c.stats().buffered_pdus == 0 && c.stats().bytes_in_use == 0, "nothing buffered");
+    }
+
+    std::cout << "MBAP split across segments:" << std::endl;
+    {
+        Client c;
+        Bytes adu = mbap(3);
+        check(c.send(1000, slice(adu, 0, 3)) == 0, "partial MBAP header is buffered");
+        check(c.send(1003, slice(adu, 3, 8)) == 0, "header complete, PDU still partial");
+        check(c.send(1008, concat(slice(adu, 8, 12), slice(mbap(4), 0, 2))) == 1 && c.pdus[0] == adu,
+              "third segment completes the ADU");
+        check(c.send(1014, slice(mbap(4), 2, 12)) == 1 && c.pdus[0] == mbap(4), "leftover bytes start the next ADU");
+        check(c.stats().buffered_pdus == 2 && c.stats().bytes_in_use == 0, "buffered PDU count and buffer drained");
+    }
+
+    std::cout << "TPKT split across segments:" << std::endl;
+    {
+        Client c;
+        c.framing = FRAMING_TPKT;
+        Bytes pdu = tpkt();
+        check(c.send(1000, slice(pdu, 0, 2)) == 0, "half of the TPKT header is buffered");
+        check(c.send(1002, slice(pdu, 2, pdu.size())) == 1 && c.pdus[0] == pdu, "rest of the PDU completes it");
+    }
+
+    std::cout << "retransmission and overlap:" << std::endl;
+    {
+        Client c;
+        check(c.send(1000, mbap(1)) == 1, "first ADU");
+        check(c.send(1000, mbap(1)) == 0 && c.stats().retransmissions == 1, "full retransmission is dropped");
+
+        // 이미 받은 마지막 4바이트 + 새 ADU
+        Bytes overlap = concat(slice(mbap(1), 8, 12), mbap(2));
+        check(c.send(1008, overlap) == 1 && c.pdus[0] == mbap(2), "overlapping segment is trimmed");
+        check(c.stats().overlaps == 1, "overlap counted");
+    }
+
+    std::cout << "out-of-order hold:" << std::endl;
+    {
+        Client c;
+        check(c.send(1000, mbap(1)) == 1, "first ADU");
+        check(c.send(1024, mbap(3)) == 0 && c.stats().out_of_order == 1, "segment ahead of next_seq is held");
+        check(c.send(1012, mbap(2)) == 2 && c.pdus[0] == mbap(2) && c.pdus[1] == mbap(3),
+              "missing segment releases the held one in order");
+        check(c.stats().bytes_in_use == 0, "held bytes released");
+    }
+
+    std::cout << "gap skip:" << std::endl;
+    {
+        TcpStreamConfig config;
+        config.max_out_of_order = 1;
+        Client c(config);
+        check(c.send(1000, mbap(1)) == 1, "first ADU");
+        check(c.send(1100, mbap(2)) == 0, "first segment after a gap is held");
+        check(c.send(1200, mbap(3)) == 1 && c.pdus[0] == mbap(3), "hold limit gives up on the gap and restarts");
+        check(c.stats().gaps == 1, "gap counted");
+        check(c.send(1212, mbap(4)) == 1 && c.pdus[0] == mbap(4), "stream continues from the new position");
+    }
+
+    std::cout << "SYN reset:" << std::endl;
+    {
+        Client c;
+        check(c.send(1000, slice(mbap(1), 0, 5)) == 0, "partial ADU left in the buffer");
+        check(c.send(5000, Bytes(), TH_SYN) == -1, "SYN without payload falls through");
+        check(c.stats().bytes_in_use == 0, "SYN drops the old buffer");
+        check(c.send(5001, mbap(2)) == 1 && c.pdus[0] == mbap(2), "new connection starts at ISN + 1");
+    }
+
+    std::cout << "FIN/RST erase:" << std::endl;
+    {
+        Client c;
+        check(c.send(1000, mbap(1), TH_ACK | TH_FIN) == 1, "FIN segment payload is still delivered");
+        check(c.stats().streams == 0, "FIN erases the stream");
+
+        check(c.send(2000, slice(mbap(2), 0, 5)) == 0 && c.stats().streams == 1, "new stream with a partial ADU");
+        check(c.send(2005, Bytes(), TH_RST) == -1, "RST without payload falls through");
+        check(c.stats().streams == 0 && c.stats().bytes_in_use == 0, "RST erases the stream and its buffer");
+    }
+
+    std::cout << "framing error:" << std::endl;
+    {
+        Client c;
+        check(c.send(1000, Bytes(8, 0x99)) == -1, "non-MBAP payload falls through to per-segment parsing");
+        check(c.stats().framing_errors == 1, "framing error counted");
+        check(c.send(1008, mbap(1)) == 1, "next valid ADU is delivered");
+    }
+
+    std::cout << (failures == 0 ? "All tests passed" : "Some tests failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}